@@ -0,0 +1,521 @@
+#include "Benchmark.hpp"
+#include "Student.hpp"
+#include "Group.hpp"
+#include "FileManager.hpp"
+#include "StudentStore.hpp"
+#include "MappedGroupFile.hpp"
+#include "GroupStreamReader.hpp"
+#include "GradeCodec.hpp"
+#include "GradeJournal.hpp"
+#include <cstring>
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <new>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+// Подсчёт выделений памяти: глобальные operator new/delete заменены
+// счётчиком, чтобы бенчмарки могли замерять аллокации на операцию.
+// Заменён весь набор (nothrow, выровненные, с размером): иначе память
+// из стандартного варианта освобождалась бы заменённым и наоборот
+static std::atomic<size_t> allocationCount(0);
+
+static void* countedAlloc(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+
+// На Windows память _aligned_malloc освобождается только _aligned_free
+static void* countedAlignedAlloc(size_t size, std::align_val_t alignment) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    // aligned_alloc требует размер, кратный выравниванию
+    return std::aligned_alloc(align, (size + align - 1) / align * align + (size ? 0 : align));
+#endif
+}
+
+static void alignedFree(void* ptr) {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else
+    std::free(ptr);
+#endif
+}
+
+void* operator new(size_t size) {
+    if (void* ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    if (void* ptr = countedAlloc(size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    if (void* ptr = countedAlignedAlloc(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    if (void* ptr = countedAlignedAlloc(size, alignment)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return countedAlloc(size); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return countedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { alignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    alignedFree(ptr);
+}
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept {
+    alignedFree(ptr);
+}
+
+size_t Benchmark::getAllocationCount() {
+    return allocationCount.load(std::memory_order_relaxed);
+}
+
+void Benchmark::runAll() {
+    std::cout << "--- Benchmark: allocations per Student ---\n";
+    runStudentAllocations(100000);
+
+    std::cout << "\n--- Benchmark: growing a student container ---\n";
+    runContainerGrowth(100000);
+
+    std::cout << "\n--- Benchmark: copy-on-write snapshots ---\n";
+    runSnapshots(10000);
+
+    std::cout << "\n--- Benchmark: parallel aggregation over a large group ---\n";
+    runParallelGroup(1000000);
+
+    std::cout << "\n--- Benchmark: virtual vs static getAverage ---\n";
+    runDispatch(1000000);
+
+    std::cout << "\n--- Benchmark: GRP2 save and load ---\n";
+    runFileRoundTrip(1000000);
+
+    std::cout << "\n--- Benchmark: packed grade column ---\n";
+    runGradeCompression(200000);
+
+    std::cout << "\n--- Benchmark: grade journal with group commit ---\n";
+    runJournal(8, 2000);
+}
+
+void Benchmark::runStudentAllocations(size_t studentCount) {
+    const std::vector<double> grades = { 4.5, 3.8, 5.0, 4.2 };
+    std::vector<Student> students;
+    std::vector<Student> copies;
+    students.reserve(studentCount);
+    copies.reserve(studentCount);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t before = getAllocationCount();
+    for (size_t i = 0; i < studentCount; ++i) {
+        students.emplace_back("Alice", "2024001", grades);
+    }
+    size_t constructed = getAllocationCount() - before;
+
+    before = getAllocationCount();
+    for (const auto& student : students) {
+        copies.push_back(student);
+    }
+    size_t copied = getAllocationCount() - before;
+    auto elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Students: " << studentCount << " (4 grades each)\n";
+    std::cout << "  Allocations per constructed Student: " << std::fixed << std::setprecision(2)
+        << static_cast<double>(constructed) / studentCount << "\n";
+    std::cout << "  Allocations per copied Student: "
+        << static_cast<double>(copied) / studentCount << "\n";
+    std::cout << "  Time: " << elapsed << " ms\n";
+}
+// Рост вектора без reserve: при noexcept-перемещении студенты переезжают
+// вместе с буферами оценок, и новых выделений, кроме самого вектора, нет
+void Benchmark::runContainerGrowth(size_t studentCount) {
+    std::vector<double> grades;
+    for (int i = 0; i < 12; ++i) {
+        grades.push_back(3.0 + (i % 5) * 0.5);
+    }
+    std::vector<Student> source;
+    source.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        source.emplace_back("Student with a long enough name", "2024001", grades);
+    }
+
+    std::vector<Student> students;
+    size_t reallocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    size_t before = getAllocationCount();
+    for (auto& student : source) {
+        size_t capacity = students.capacity();
+        students.push_back(std::move(student));
+        if (students.capacity() != capacity) ++reallocations;
+    }
+    size_t allocations = getAllocationCount() - before;
+    auto elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Students: " << studentCount << " (12 grades each, heap-allocated)\n";
+    std::cout << "  Vector reallocations: " << reallocations << "\n";
+    std::cout << "  Name/grade buffer copies: " << allocations - reallocations << "\n";
+    std::cout << "  Time: " << std::fixed << std::setprecision(2) << elapsed << " ms\n";
+}
+
+// Снимки для отчётов разделяют блок оценок, пока одна из сторон его не изменит
+void Benchmark::runSnapshots(size_t snapshotCount) {
+    std::vector<double> grades(1000, 4.0);
+    Student original("Alice", "2024001", grades);
+    std::vector<Student> snapshots;
+    snapshots.reserve(snapshotCount);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t before = getAllocationCount();
+    for (size_t i = 0; i < snapshotCount; ++i) {
+        snapshots.push_back(original);
+    }
+    size_t copied = getAllocationCount() - before;
+    auto elapsed = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    before = getAllocationCount();
+    original.addGrade(5.0);
+    size_t detached = getAllocationCount() - before;
+
+    std::cout << "Snapshots: " << snapshotCount << " of a student with 1000 grades\n";
+    std::cout << "  Allocations while taking snapshots: " << copied << "\n";
+    std::cout << "  Allocations on first write after snapshot: " << detached << "\n";
+    std::cout << "  Time: " << std::fixed << std::setprecision(2) << elapsed << " ms\n";
+}
+
+// Полный проход по большой группе: последовательно и по потокам
+void Benchmark::runParallelGroup(size_t studentCount) {
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        double grade = static_cast<double>(i * 7919 % 51) / 10.0;
+        students.emplace_back("Student " + std::to_string(i * 7919 % studentCount), "2024001",
+            std::vector<double>{ grade, 5.0 - grade / 2 });
+    }
+    Group group("Faculty");
+    for (auto& student : students) {
+        group.addStudent(student);
+    }
+
+    auto byName = [](const Student& a, const Student& b) { return a.getName() < b.getName(); };
+    double times[2][3];
+    size_t found = 0;
+    for (int mode = 0; mode < 2; ++mode) {
+        Execution execution = mode ? Execution::Parallel : Execution::Serial;
+        auto start = std::chrono::steady_clock::now();
+        volatile double average = group.calculateGroupAverage(execution);
+        (void)average;
+        auto afterAverage = std::chrono::steady_clock::now();
+        found = group.filterByThreshold(3.5, execution).size();
+        auto afterFilter = std::chrono::steady_clock::now();
+        group.sortStudents(byName, execution);
+        auto afterSort = std::chrono::steady_clock::now();
+        times[mode][0] = std::chrono::duration<double, std::milli>(afterAverage - start).count();
+        times[mode][1] = std::chrono::duration<double, std::milli>(afterFilter - afterAverage).count();
+        times[mode][2] = std::chrono::duration<double, std::milli>(afterSort - afterFilter).count();
+        if (mode == 0) group.sortStudentsByAverage();
+    }
+
+    std::cout << "Students: " << studentCount << ", threads: " << Parallel::getThreadCount()
+        << ", cutoff: " << Parallel::getCutoff() << "\n";
+    std::cout << "  Students with average >= 3.5: " << found << "\n";
+    const char* labels[3] = { "Full average scan", "Threshold filter", "Sort by name" };
+    for (int i = 0; i < 3; ++i) {
+        std::cout << "  " << labels[i] << ": serial " << std::fixed << std::setprecision(2)
+            << times[0][i] << " ms, parallel " << times[1][i] << " ms\n";
+    }
+
+    // Те же проходы по SoA-таблице вместо цепочки указателей
+    group.setColumnsEnabled(true);
+    auto start = std::chrono::steady_clock::now();
+    volatile double average = group.calculateGroupAverage(Execution::Serial);
+    (void)average;
+    auto afterAverage = std::chrono::steady_clock::now();
+    group.filterByThreshold(3.5, Execution::Serial);
+    auto afterFilter = std::chrono::steady_clock::now();
+    std::cout << "  With SoA columns (serial): average scan "
+        << std::chrono::duration<double, std::milli>(afterAverage - start).count()
+        << " ms, threshold filter "
+        << std::chrono::duration<double, std::milli>(afterFilter - afterAverage).count()
+        << " ms\n";
+}
+
+// Сумма средних через Person* (виртуальный вызов) и через Student*
+// (final: статический вызов, встроенный до чтения поля)
+void Benchmark::runDispatch(size_t studentCount) {
+    std::vector<Student> students;
+    students.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        double grade = static_cast<double>(i % 51) / 10.0;
+        students.emplace_back("Student", "2024001", std::vector<double>{ grade });
+    }
+    std::vector<Person*> persons;
+    std::vector<Student*> direct;
+    persons.reserve(studentCount);
+    direct.reserve(studentCount);
+    for (auto& student : students) {
+        persons.push_back(&student);
+        direct.push_back(&student);
+    }
+
+    const int passes = 20;
+    double virtualSum = 0.0;
+    auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const Person* person : persons) virtualSum += person->getAverage();
+    }
+    auto afterVirtual = std::chrono::steady_clock::now();
+    double staticSum = 0.0;
+    for (int pass = 0; pass < passes; ++pass) {
+        for (const Student* student : direct) staticSum += student->getAverage();
+    }
+    auto afterStatic = std::chrono::steady_clock::now();
+
+    std::cout << "Students: " << studentCount << ", passes: " << passes
+        << (virtualSum == staticSum ? "" : " (sums differ!)") << "\n";
+    std::cout << "  Virtual dispatch (Person*): " << std::fixed << std::setprecision(2)
+        << std::chrono::duration<double, std::milli>(afterVirtual - start).count() << " ms\n";
+    std::cout << "  Static dispatch (Student*): "
+        << std::chrono::duration<double, std::milli>(afterStatic - afterVirtual).count() << " ms\n";
+}
+
+// Сохранение и полная загрузка группы в формате GRP2
+void Benchmark::runFileRoundTrip(size_t studentCount) {
+    const std::string filename = "benchmark_group.bin";
+    double saveTime = 0.0;
+    double fileSize = 0.0;
+    {
+        StudentStore store;
+        std::vector<Student*> batch;
+        batch.reserve(studentCount);
+        for (size_t i = 0; i < studentCount; ++i) {
+            double grade = static_cast<double>(i % 51) / 10.0;
+            StudentHandle handle = store.create("Student " + std::to_string(i), "2024001",
+                std::vector<double>{ grade, 5.0 - grade, 4.0, 3.5 });
+            batch.push_back(store.get(handle));
+        }
+        Group group("Faculty");
+        group.addStudents(batch);
+
+        auto start = std::chrono::steady_clock::now();
+        FileManager::saveGroup(group, filename);
+        saveTime = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        fileSize = static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+    }
+
+    StudentStore store;
+    Group loaded;
+    auto start = std::chrono::steady_clock::now();
+    bool ok = FileManager::loadGroup(loaded, store, filename);
+    double loadTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "Students: " << studentCount << ", file: " << std::fixed << std::setprecision(2)
+        << fileSize << " MB\n";
+    std::cout << "  Save: " << saveTime << " ms (" << fileSize * 1000.0 / saveTime << " MB/s)\n";
+    std::cout << "  Load: " << loadTime << " ms, students loaded: "
+        << (ok ? loaded.getStudentCount() : 0) << "\n";
+
+    // Отображение: открытие не зависит от размера файла, проход читает страницы
+    start = std::chrono::steady_clock::now();
+    MappedGroupFile mapped;
+    mapped.open(filename);
+    auto afterOpen = std::chrono::steady_clock::now();
+    double sum = 0.0;
+    for (size_t i = 0; i < mapped.getStudentCount(); ++i) {
+        sum += mapped.getStudent(i).getAverage();
+    }
+    auto afterScan = std::chrono::steady_clock::now();
+    std::cout << "  Mapped open: " << std::setprecision(3)
+        << std::chrono::duration<double, std::milli>(afterOpen - start).count()
+        << " ms, mapped average scan: " << std::setprecision(2)
+        << std::chrono::duration<double, std::milli>(afterScan - afterOpen).count() << " ms (avg "
+        << (mapped.getStudentCount() ? sum / mapped.getStudentCount() : 0.0) << ")\n";
+    mapped.close();
+
+    // Потоковый проход с фиксированным бюджетом памяти
+    start = std::chrono::steady_clock::now();
+    GroupStreamReader reader;
+    size_t batches = 0;
+    size_t streamed = 0;
+    sum = 0.0;
+    if (reader.open(filename, 1024 * 1024)) {
+        reader.forEachBatch([&](const std::vector<StudentView>& batch) {
+            ++batches;
+            streamed += batch.size();
+            for (const auto& view : batch) sum += view.getAverage();
+        });
+        reader.close();
+    }
+    auto afterStream = std::chrono::steady_clock::now();
+    std::cout << "  Streamed average (1 MB budget): "
+        << std::chrono::duration<double, std::milli>(afterStream - start).count() << " ms, "
+        << batches << " batches (avg " << (streamed ? sum / streamed : 0.0) << ")\n";
+    loaded.clear();
+    std::remove(filename.c_str());
+}
+
+// Размер колонки оценок и скорость декодирования: сырые double и GradeCodec.
+// Оценки - кратные 0.1 в диапазоне 3.0..5.0 с сериями одинаковых
+void Benchmark::runGradeCompression(size_t studentCount) {
+    const size_t gradesPerStudent = 20;
+    std::vector<double> grades;
+    grades.reserve(studentCount * gradesPerStudent);
+    size_t seed = 12345;
+    for (size_t i = 0; i < studentCount * gradesPerStudent; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        bool repeat = !grades.empty() && (seed >> 60) < 6;
+        grades.push_back(repeat ? grades.back() : static_cast<double>(30 + (seed >> 33) % 21) / 10.0);
+    }
+
+    std::vector<double> decoded(grades.size());
+    auto start = std::chrono::steady_clock::now();
+    std::vector<uint8_t> packed = GradeCodec::encode(grades.data(), grades.size());
+    auto afterEncode = std::chrono::steady_clock::now();
+    bool ok = GradeCodec::decode(packed.data(), packed.size(), decoded.data(), decoded.size());
+    auto afterDecode = std::chrono::steady_clock::now();
+    std::vector<double> copied(grades.size());
+    std::memcpy(copied.data(), grades.data(), grades.size() * sizeof(double));
+    auto afterCopy = std::chrono::steady_clock::now();
+
+    double rawBytes = static_cast<double>(grades.size() * sizeof(double));
+    double decodeTime = std::chrono::duration<double, std::milli>(afterDecode - afterEncode).count();
+    double copyTime = std::chrono::duration<double, std::milli>(afterCopy - afterDecode).count();
+    std::cout << "Grades: " << grades.size() << (ok && decoded == grades ? "" : " (decode mismatch!)")
+        << "\n";
+    std::cout << "  Raw column: " << std::fixed << std::setprecision(2)
+        << rawBytes / (1024.0 * 1024.0) << " MB, packed: "
+        << packed.size() / (1024.0 * 1024.0) << " MB ("
+        << rawBytes / packed.size() << "x smaller)\n";
+    std::cout << "  Encode: " << std::chrono::duration<double, std::milli>(afterEncode - start).count()
+        << " ms, decode: " << decodeTime << " ms (" << rawBytes / (1024.0 * 1024.0) / decodeTime * 1000.0
+        << " MB/s of doubles), raw copy: " << copyTime << " ms\n";
+
+    // Те же оценки в файле группы. Чтение и разбор файла замеряются отдельно
+    // от добавления в группу: упаковка ускоряет только первое, и то лишь
+    // за счёт меньшего объёма ввода - только что записанный файл лежит в
+    // кэше ОС, так что здесь выигрыш в основном в размере файла
+    StudentStore store;
+    std::vector<Student*> batch;
+    batch.reserve(studentCount);
+    for (size_t i = 0; i < studentCount; ++i) {
+        Student* student = store.get(store.create("Student " + std::to_string(i), "2024001"));
+        student->ingestGrades(grades.data() + i * gradesPerStudent, gradesPerStudent);
+        batch.push_back(student);
+    }
+    Group group("Faculty");
+    group.addStudents(batch);
+    const char* names[2] = { "benchmark_raw.bin", "benchmark_packed.bin" };
+    for (int i = 0; i < 2; ++i) {
+        FileManager::saveGroup(group, names[i], i ? GradeEncoding::Packed : GradeEncoding::Raw);
+        std::ifstream file(names[i], std::ios::binary | std::ios::ate);
+        double size = static_cast<double>(file.tellg()) / (1024.0 * 1024.0);
+        file.close();
+        StudentStore loadedStore;
+        std::vector<Student*> students;
+        std::string groupName;
+        auto loadStart = std::chrono::steady_clock::now();
+        FileManager::readStudents(loadedStore, students, groupName, names[i]);
+        auto afterRead = std::chrono::steady_clock::now();
+        Group loaded(groupName);
+        loaded.addStudents(students);
+        auto afterGroup = std::chrono::steady_clock::now();
+        std::cout << "  " << (i ? "Packed" : "Raw") << " file: " << size << " MB, read "
+            << std::chrono::duration<double, std::milli>(afterRead - loadStart).count()
+            << " ms, group indexing "
+            << std::chrono::duration<double, std::milli>(afterGroup - afterRead).count() << " ms\n";
+        loaded.clear();
+        std::remove(names[i]);
+    }
+}
+
+// Оценки из нескольких потоков через журнал: сколько записей приходится
+// на один fsync и во что обходятся уплотнение и перезапуск
+void Benchmark::runJournal(size_t threadCount, size_t gradesPerThread) {
+    const std::string snapshot = "benchmark_journal.grp";
+    const std::string journalName = "benchmark_journal.log";
+    GradeJournal journal;
+    if (!journal.open(snapshot, journalName, "Faculty")) return;
+    for (size_t i = 0; i < threadCount; ++i) {
+        journal.enrollStudent("Student " + std::to_string(i), "2024001");
+    }
+    size_t syncsBefore = journal.getSyncCount();
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < threadCount; ++t) {
+        writers.emplace_back([&journal, t, gradesPerThread]() {
+            std::string name = "Student " + std::to_string(t);
+            for (size_t i = 0; i < gradesPerThread; ++i) {
+                journal.addGrade(name, static_cast<double>(30 + (t + i) % 21) / 10.0);
+            }
+        });
+    }
+    for (auto& writer : writers) writer.join();
+    double writeTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    size_t grades = threadCount * gradesPerThread;
+    size_t syncs = journal.getSyncCount() - syncsBefore;
+
+    std::cout << "Grades: " << grades << " from " << threadCount << " threads in " << std::fixed
+        << std::setprecision(2) << writeTime << " ms (" << grades * 1000.0 / writeTime
+        << " grades/s)\n";
+    std::cout << "  fsync calls: " << syncs << " (" << static_cast<double>(grades) / syncs
+        << " grades per fsync), journal: " << journal.getJournalSize() / 1024.0 << " KB\n";
+
+    start = std::chrono::steady_clock::now();
+    journal.startCompaction();
+    journal.waitForCompaction();
+    double compactTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    journal.addGrade("Student 0", 5.0);
+    journal.close();
+
+    start = std::chrono::steady_clock::now();
+    bool reopened = journal.open(snapshot, journalName);
+    double openTime = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    size_t restored = 0;
+    journal.inspect([&restored](const Group& group) {
+        for (const auto* student : group.getStudents()) restored += student->getGrades().size();
+    });
+    std::cout << "  Compaction: " << compactTime << " ms, reopen: " << openTime
+        << " ms, grades restored: " << (reopened ? restored : 0) << "\n";
+    journal.close();
+    std::remove(snapshot.c_str());
+    std::remove(journalName.c_str());
+}
\ No newline at end of file
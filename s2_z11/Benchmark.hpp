@@ -0,0 +1,23 @@
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <cstddef>
+
+class Benchmark {
+public:
+    static size_t getAllocationCount();
+
+    // Все замеры подряд, с заголовками
+    static void runAll();
+
+    static void runStudentAllocations(size_t studentCount);
+    static void runContainerGrowth(size_t studentCount);
+    static void runSnapshots(size_t snapshotCount);
+    static void runParallelGroup(size_t studentCount);
+    static void runDispatch(size_t studentCount);
+    static void runFileRoundTrip(size_t studentCount);
+    static void runGradeCompression(size_t studentCount);
+    static void runJournal(size_t threadCount, size_t gradesPerThread);
+};
+
+#endif
\ No newline at end of file
@@ -1,25 +1,117 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "FileManager.hpp"
+#include "GradeCodec.hpp"
 #include <iostream>
 #include <cstring>
+#include <vector>
 
-bool FileManager::saveGroup(const Group& group, const std::string& filename) {
+bool FileManager::writeString(std::ofstream& file, const std::string& str) {
+    uint32_t length = static_cast<uint32_t>(str.size());
+    file.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    file.write(str.data(), length);
+    return static_cast<bool>(file);
+}
+
+bool FileManager::readString(std::ifstream& file, std::string& str) {
+    uint32_t length = 0;
+    if (!file.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+    str.resize(length);
+    return length == 0 || static_cast<bool>(file.read(&str[0], length));
+}
+
+// Общая часть заголовка GRP1/GRP2. Для GRP2 дочитывает таблицу секций
+// и полное имя группы
+bool FileManager::readHeader(std::ifstream& file, FileHeader& header, std::string& groupName,
+    SectionTable* sections) {
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Error: File is too short\n";
+        return false;
+    }
+
+    bool isGrp1 = memcmp(header.signature, "GRP1", 4) == 0;
+    bool isGrp2 = memcmp(header.signature, "GRP2", 4) == 0;
+    if (!isGrp1 && !isGrp2) {
+        std::cerr << "Error: Invalid file signature\n";
+        return false;
+    }
+
+    if ((isGrp1 && header.version != 1) ||
+        (isGrp2 && header.version != 2 && header.version != 3)) {
+        std::cerr << "Error: Unsupported file version\n";
+        return false;
+    }
+
+    if (isGrp1) {
+        groupName.assign(header.groupName, strnlen(header.groupName, sizeof(header.groupName)));
+        return true;
+    }
+
+    SectionTable table;
+    if (!file.read(reinterpret_cast<char*>(&table), sizeof(table)) ||
+        !readString(file, groupName)) {
+        std::cerr << "Error: Corrupted file header\n";
+        return false;
+    }
+    if (sections) *sections = table;
+    return true;
+}
+
+bool FileManager::saveGroup(const Group& group, const std::string& filename,
+    GradeEncoding encoding) {
+    if (!writeStudents(group.getStudents(), group.getName(), filename, encoding)) return false;
+    std::cout << "Group saved to " << filename << "\n";
+    return true;
+}
+
+// Секции собираются в памяти и уходят в файл одной записью каждая
+bool FileManager::writeStudents(const std::vector<Student*>& students,
+    const std::string& groupName, const std::string& filename, GradeEncoding encoding) {
     std::ofstream file(filename, std::ios::binary);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot open file for writing: " << filename << "\n";
         return false;
     }
 
+    size_t totalGrades = 0;
+    size_t totalChars = 0;
+    for (const auto* student : students) {
+        totalGrades += student->getGrades().size();
+        totalChars += student->getName().size() + student->getRecordNumber().size();
+    }
+
+    std::vector<StudentRecord> records(students.size());
+    std::vector<double> grades;
+    std::string strings;
+    grades.reserve(totalGrades);
+    strings.reserve(totalChars);
+    for (size_t i = 0; i < students.size(); ++i) {
+        const Student& student = *students[i];
+        StudentRecord& record = records[i];
+        std::string number = student.getRecordNumber();
+        GradeView view = student.getGrades();
+
+        record.nameOffset = strings.size();
+        record.nameLength = static_cast<uint32_t>(student.getName().size());
+        strings += student.getName();
+        record.numberOffset = strings.size();
+        record.numberLength = static_cast<uint32_t>(number.size());
+        strings += number;
+        record.gradeOffset = grades.size();
+        record.gradeCount = static_cast<uint32_t>(view.size());
+        grades.insert(grades.end(), view.begin(), view.end());
+        record.reserved = 0;
+        record.gradeStep = student.getGradeStep();
+    }
+
     FileHeader header;
 
     // Копируем сигнатуру
-    memcpy(header.signature, "GRP1", 4);
+    memcpy(header.signature, "GRP2", 4);
 
-    header.version = 1;
-    header.studentCount = static_cast<uint32_t>(group.getStudentCount());
+    header.version = encoding == GradeEncoding::Packed ? 3 : 2;
+    header.studentCount = static_cast<uint32_t>(students.size());
 
-    // Копируем название группы
-    std::string groupName = group.getName();
+    // Копируем название группы (полное имя хранится после таблицы секций)
     size_t copyLength = groupName.length();
     if (copyLength > 49) copyLength = 49;
 
@@ -31,10 +123,40 @@ bool FileManager::saveGroup(const Group& group, const std::string& filename) {
         memset(header.groupName + copyLength, 0, 49 - copyLength);
     }
 
+    std::vector<uint8_t> packed;
+    const char* gradeBytes = reinterpret_cast<const char*>(grades.data());
+    uint64_t gradeSize = grades.size() * sizeof(double);
+    if (encoding == GradeEncoding::Packed) {
+        packed = GradeCodec::encode(grades.data(), grades.size());
+        gradeBytes = reinterpret_cast<const char*>(packed.data());
+        gradeSize = packed.size();
+    }
+
+    uint64_t position = sizeof(FileHeader) + sizeof(SectionTable) + sizeof(uint32_t) +
+        groupName.size();
+    uint64_t padding = (8 - position % 8) % 8;
+    SectionTable sections;
+    sections.recordsOffset = position + padding;
+    sections.gradesOffset = sections.recordsOffset + records.size() * sizeof(StudentRecord);
+    sections.gradeCount = grades.size();
+    sections.stringsOffset = sections.gradesOffset + gradeSize;
+    sections.stringsSize = strings.size();
+
+    const char zeros[8] = {};
     file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&sections), sizeof(sections));
+    writeString(file, groupName);
+    file.write(zeros, static_cast<std::streamsize>(padding));
+    file.write(reinterpret_cast<const char*>(records.data()),
+        static_cast<std::streamsize>(records.size() * sizeof(StudentRecord)));
+    file.write(gradeBytes, static_cast<std::streamsize>(gradeSize));
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
     file.close();
 
-    std::cout << "Group saved to " << filename << "\n";
+    if (!file) {
+        std::cerr << "Error: Failed to write file: " << filename << "\n";
+        return false;
+    }
     return true;
 }
 
@@ -46,21 +168,113 @@ bool FileManager::loadGroup(Group& group, const std::string& filename) {
     }
 
     FileHeader header;
-    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::string groupName;
+    if (!readHeader(file, header, groupName, nullptr)) return false;
+    if (header.version >= 2 && header.studentCount > 0) {
+        std::cerr << "Error: File contains students, load it with a StudentStore: " << filename << "\n";
+        return false;
+    }
 
-    if (memcmp(header.signature, "GRP1", 4) != 0) {
-        std::cerr << "Error: Invalid file signature\n";
+    group.setName(std::move(groupName));
+    file.close();
+
+    std::cout << "Group loaded from " << filename << "\n";
+    return true;
+}
+
+bool FileManager::loadGroup(Group& group, StudentStore& store, const std::string& filename) {
+    std::vector<Student*> batch;
+    std::string groupName;
+    if (!readStudents(store, batch, groupName, filename)) return false;
+
+    group.setName(std::move(groupName));
+    group.addStudents(batch);
+
+    std::cout << "Group loaded from " << filename << "\n";
+    return true;
+}
+
+// Каждая секция читается одним вызовом; все записи проверяются
+// до создания первого студента, чтобы битый файл не оставил полгруппы
+bool FileManager::readStudents(StudentStore& store, std::vector<Student*>& students,
+    std::string& groupName, const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file for reading: " << filename << "\n";
         return false;
     }
 
-    if (header.version != 1) {
-        std::cerr << "Error: Unsupported file version\n";
+    FileHeader header;
+    SectionTable sections;
+    if (!readHeader(file, header, groupName, &sections)) return false;
+    if (header.version < 2) {
+        std::cerr << "Error: File has no student records\n";
         return false;
     }
 
-    group.setName(header.groupName);
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    uint64_t recordsSize = uint64_t(header.studentCount) * sizeof(StudentRecord);
+    bool packed = header.version == 3;
+    // Сжатый блок не даёт больше 128 оценок на байт
+    uint64_t gradeSize = packed ? sections.stringsOffset - sections.gradesOffset
+        : sections.gradeCount * sizeof(double);
+    if ((!packed && sections.gradeCount > fileSize / sizeof(double)) ||
+        sections.recordsOffset > fileSize || recordsSize > fileSize - sections.recordsOffset ||
+        sections.gradesOffset > fileSize ||
+        (packed && (sections.stringsOffset < sections.gradesOffset ||
+            sections.gradeCount > gradeSize * 128)) ||
+        gradeSize > fileSize - sections.gradesOffset ||
+        sections.stringsOffset > fileSize || sections.stringsSize > fileSize - sections.stringsOffset) {
+        std::cerr << "Error: Corrupted section table\n";
+        return false;
+    }
+
+    std::vector<StudentRecord> records(header.studentCount);
+    std::vector<double> grades(sections.gradeCount);
+    std::string strings(sections.stringsSize, '\0');
+    file.seekg(static_cast<std::streamoff>(sections.recordsOffset));
+    file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(recordsSize));
+    std::vector<uint8_t> packedGrades(packed ? gradeSize : 0);
+    file.seekg(static_cast<std::streamoff>(sections.gradesOffset));
+    if (packed) {
+        file.read(reinterpret_cast<char*>(packedGrades.data()),
+            static_cast<std::streamsize>(packedGrades.size()));
+    }
+    else {
+        file.read(reinterpret_cast<char*>(grades.data()), static_cast<std::streamsize>(gradeSize));
+    }
+    file.seekg(static_cast<std::streamoff>(sections.stringsOffset));
+    file.read(&strings[0], static_cast<std::streamsize>(strings.size()));
+    if (!file) {
+        std::cerr << "Error: Failed to read file: " << filename << "\n";
+        return false;
+    }
+    if (packed && !GradeCodec::decode(packedGrades.data(), packedGrades.size(),
+        grades.data(), grades.size())) {
+        std::cerr << "Error: Corrupted grade column\n";
+        return false;
+    }
     file.close();
 
-    std::cout << "Group loaded from " << filename << "\n";
+    for (const auto& record : records) {
+        if (record.nameOffset > strings.size() || record.nameLength > strings.size() - record.nameOffset ||
+            record.numberOffset > strings.size() ||
+            record.numberLength > strings.size() - record.numberOffset ||
+            record.gradeOffset > grades.size() || record.gradeCount > grades.size() - record.gradeOffset) {
+            std::cerr << "Error: Corrupted student record\n";
+            return false;
+        }
+    }
+
+    students.reserve(students.size() + records.size());
+    for (const auto& record : records) {
+        StudentHandle handle = store.create(strings.substr(record.nameOffset, record.nameLength),
+            strings.substr(record.numberOffset, record.numberLength));
+        Student* student = store.get(handle);
+        if (record.gradeStep > 0.0) student->setGradeStep(record.gradeStep);
+        student->ingestGrades(grades.data() + record.gradeOffset, record.gradeCount);
+        students.push_back(student);
+    }
     return true;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <string>
 #include <fstream>
 #include "Group.hpp"
+#include "StudentStore.hpp"
 
 #pragma pack(push, 1)
 struct FileHeader {
@@ -12,16 +13,61 @@ struct FileHeader {
     uint32_t studentCount;
     char groupName[50];
 };
+
+// GRP2: после FileHeader идут таблица секций и полное имя группы
+// (writeString), затем секции, каждая пишется одним блоком:
+//   StudentRecord[studentCount] | double[gradeCount] | строки без разделителей
+// Записи и оценки выровнены по 8 байт, смещения - от начала файла.
+// Версия 3 - тот же формат, но секция оценок сжата GradeCodec и занимает
+// место до начала таблицы строк
+struct SectionTable {
+    uint64_t recordsOffset;
+    uint64_t gradesOffset;
+    uint64_t gradeCount;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+};
+
+// Смещения строк - в байтах от начала таблицы строк,
+// смещение оценок - в элементах от начала блока оценок
+struct StudentRecord {
+    uint64_t nameOffset;
+    uint64_t numberOffset;
+    uint64_t gradeOffset;
+    uint32_t nameLength;
+    uint32_t numberLength;
+    uint32_t gradeCount;
+    uint32_t reserved;
+    double gradeStep;
+};
 #pragma pack(pop)
 
+enum class GradeEncoding { Raw, Packed };
+
 class FileManager {
 public:
-    static bool saveGroup(const Group& group, const std::string& filename);
+    // Сохраняет группу целиком в формате GRP2. Packed сжимает оценки,
+    // но такой файл не читается через отображение и потоково
+    static bool saveGroup(const Group& group, const std::string& filename,
+        GradeEncoding encoding = GradeEncoding::Raw);
+    // Читает только имя группы: GRP1 или GRP2 без студентов. Студентов
+    // из GRP2 загружает только перегрузка со StudentStore
     static bool loadGroup(Group& group, const std::string& filename);
+    // Полная загрузка GRP2: студенты создаются в store и добавляются в group
+    static bool loadGroup(Group& group, StudentStore& store, const std::string& filename);
+
+    // То же без Group и без сообщений в stdout - для фоновых задач.
+    // readStudents дописывает студентов в конец students
+    static bool writeStudents(const std::vector<Student*>& students, const std::string& groupName,
+        const std::string& filename, GradeEncoding encoding = GradeEncoding::Raw);
+    static bool readStudents(StudentStore& store, std::vector<Student*>& students,
+        std::string& groupName, const std::string& filename);
 
 private:
     static bool writeString(std::ofstream& file, const std::string& str);
     static bool readString(std::ifstream& file, std::string& str);
+    static bool readHeader(std::ifstream& file, FileHeader& header, std::string& groupName,
+        SectionTable* sections);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,169 @@
+#ifndef GRADEBUFFER_HPP
+#define GRADEBUFFER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Контейнер с встроенным буфером на InlineCapacity элементов. Пока оценок
+// немного, куча не используется; при переполнении данные переезжают в кучу.
+// Блок в куче разделяется между копиями со счётчиком ссылок и копируется
+// только при первом изменении (copy-on-write), поэтому снимок зачётки
+// стоит O(1) независимо от числа оценок.
+// Встроенный буфер и указатель на блок занимают одну и ту же память:
+// данные лежат в куче, только когда ёмкость больше встроенной.
+// Рассчитан только на тривиально копируемые типы (double, uint8_t)
+template <typename T, size_t InlineCapacity>
+class GradeBuffer {
+    static_assert(std::is_trivially_copyable<T>::value,
+        "GradeBuffer stores trivially copyable values only");
+
+private:
+    using Block = std::shared_ptr<T[]>;
+
+    union {
+        T inlineData[InlineCapacity];
+        Block heapBlock;
+    };
+    std::uint32_t count;
+    std::uint32_t capacity;
+
+    inline bool isInline() const { return capacity == InlineCapacity; }
+    inline T* items() { return isInline() ? inlineData : heapBlock.get(); }
+    inline const T* items() const { return isInline() ? inlineData : heapBlock.get(); }
+
+    void grow(size_t minCapacity) {
+        size_t newCapacity = size_t(capacity) * 2;
+        if (newCapacity < minCapacity) newCapacity = minCapacity;
+        reallocate(newCapacity);
+    }
+
+    // Данные копируются в новый блок до того, как указатель на него
+    // займёт место встроенного буфера
+    void reallocate(size_t newCapacity) {
+        Block block = std::make_shared_for_overwrite<T[]>(newCapacity);
+        if (count) std::memcpy(block.get(), items(), count * sizeof(T));
+        if (isInline()) new (&heapBlock) Block(std::move(block));
+        else heapBlock = std::move(block);
+        capacity = static_cast<std::uint32_t>(newCapacity);
+    }
+
+    // Перед записью в разделяемый блок снимаем с него собственную копию
+    void makeUnique() {
+        if (isShared()) reallocate(capacity);
+    }
+
+    // Оба вызываются только для пустого встроенного буфера
+    void copyFrom(const GradeBuffer& other) {
+        if (other.isInline()) {
+            if (other.count) std::memcpy(inlineData, other.inlineData, other.count * sizeof(T));
+        }
+        else {
+            new (&heapBlock) Block(other.heapBlock);
+        }
+        capacity = other.capacity;
+        count = other.count;
+    }
+
+    void stealFrom(GradeBuffer& other) {
+        if (other.isInline()) {
+            if (other.count) std::memcpy(inlineData, other.inlineData, other.count * sizeof(T));
+        }
+        else {
+            new (&heapBlock) Block(std::move(other.heapBlock));
+            other.heapBlock.~Block();
+            capacity = other.capacity;
+            other.capacity = InlineCapacity;
+        }
+        count = other.count;
+        other.count = 0;
+    }
+
+    void release() {
+        if (isInline()) return;
+        heapBlock.~Block();
+        capacity = InlineCapacity;
+    }
+
+public:
+    GradeBuffer() : count(0), capacity(InlineCapacity) {}
+
+    GradeBuffer(const GradeBuffer& other) : count(0), capacity(InlineCapacity) {
+        copyFrom(other);
+    }
+
+    GradeBuffer(GradeBuffer&& other) noexcept : count(0), capacity(InlineCapacity) {
+        stealFrom(other);
+    }
+
+    GradeBuffer& operator=(const GradeBuffer& other) {
+        if (this != &other) {
+            release();
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    GradeBuffer& operator=(GradeBuffer&& other) noexcept {
+        if (this != &other) {
+            release();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    ~GradeBuffer() { release(); }
+
+    void push_back(T value) {
+        if (count == capacity) grow(size_t(count) + 1);
+        else makeUnique();
+        items()[count++] = value;
+    }
+
+    // Уменьшение размера не трогает данные, поэтому разделяемый блок не копируется
+    void pop_back() { --count; }
+    void clear() { count = 0; }
+
+    void reserve(size_t newCapacity) {
+        if (newCapacity > capacity) grow(newCapacity);
+    }
+
+    // Новые элементы не инициализируются: вызывающий код заполняет их сам
+    void resize(size_t newCount) {
+        reserve(newCount);
+        makeUnique();
+        count = static_cast<std::uint32_t>(newCount);
+    }
+
+    // Возвращает данные во встроенный буфер, если они туда помещаются
+    void shrink_to_fit() {
+        if (isInline() || count > InlineCapacity) return;
+        Block block = std::move(heapBlock);
+        heapBlock.~Block();
+        if (count) std::memcpy(inlineData, block.get(), count * sizeof(T));
+        capacity = InlineCapacity;
+    }
+
+    // Чтение никогда не копирует разделяемый блок; запись возможна только
+    // через data(), которая сначала делает блок собственным
+    const T& operator[](size_t index) const { return items()[index]; }
+    const T& back() const { return items()[count - 1]; }
+
+    T* data() { makeUnique(); return items(); }
+    const T* data() const { return items(); }
+    const T* begin() const { return items(); }
+    const T* end() const { return items() + count; }
+
+    size_t size() const { return count; }
+    size_t getCapacity() const { return capacity; }
+
+    inline bool empty() const { return count == 0; }
+    inline bool usesHeap() const { return !isInline(); }
+    inline bool isShared() const { return !isInline() && heapBlock.use_count() > 1; }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "GradeCodec.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+// Таблица декодирования: код -> оценка, точно как при делении на 10
+static const struct GradeTable {
+    double values[256];
+    GradeTable() {
+        for (int code = 0; code < 256; ++code) values[code] = code / 10.0;
+    }
+} gradeTable;
+
+bool GradeCodec::toCodes(const double* grades, size_t count, std::uint8_t* codes) {
+    for (size_t i = 0; i < count; ++i) {
+        double scaled = grades[i] * 10.0;
+        if (!(scaled >= 0.0 && scaled <= 50.0)) return false;
+        long code = std::lround(scaled);
+        if (gradeTable.values[code] != grades[i]) return false;
+        codes[i] = static_cast<std::uint8_t>(code);
+    }
+    return true;
+}
+
+// Биты кодов идут подряд от младших к старшим
+void GradeCodec::encodePacked(const std::uint8_t* codes, size_t count,
+    std::vector<std::uint8_t>& out) {
+    std::uint8_t base = *std::min_element(codes, codes + count);
+    std::uint8_t top = *std::max_element(codes, codes + count);
+    unsigned width = static_cast<unsigned>(std::bit_width(static_cast<unsigned>(top - base)));
+    out.push_back(Packed);
+    out.push_back(base);
+    out.push_back(static_cast<std::uint8_t>(width));
+    if (width == 0) return;
+
+    std::uint64_t buffer = 0;
+    unsigned filled = 0;
+    for (size_t i = 0; i < count; ++i) {
+        buffer |= std::uint64_t(codes[i] - base) << filled;
+        filled += width;
+        while (filled >= 8) {
+            out.push_back(static_cast<std::uint8_t>(buffer));
+            buffer >>= 8;
+            filled -= 8;
+        }
+    }
+    if (filled) out.push_back(static_cast<std::uint8_t>(buffer));
+}
+
+void GradeCodec::encodeRuns(const std::uint8_t* codes, size_t count,
+    std::vector<std::uint8_t>& out) {
+    out.push_back(Runs);
+    size_t i = 0;
+    while (i < count) {
+        size_t run = 1;
+        while (i + run < count && codes[i + run] == codes[i] && run < 255) ++run;
+        out.push_back(codes[i]);
+        out.push_back(static_cast<std::uint8_t>(run));
+        i += run;
+    }
+}
+
+std::vector<std::uint8_t> GradeCodec::encode(const double* grades, size_t count) {
+    std::vector<std::uint8_t> out;
+    out.reserve(count + Padding);
+    std::uint8_t codes[BlockSize];
+    std::vector<std::uint8_t> packed;
+    std::vector<std::uint8_t> runs;
+    for (size_t start = 0; start < count; start += BlockSize) {
+        size_t length = count - start < BlockSize ? count - start : BlockSize;
+        if (!toCodes(grades + start, length, codes)) {
+            out.push_back(Raw);
+            const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(grades + start);
+            out.insert(out.end(), bytes, bytes + length * sizeof(double));
+            continue;
+        }
+        packed.clear();
+        runs.clear();
+        encodePacked(codes, length, packed);
+        encodeRuns(codes, length, runs);
+        const std::vector<std::uint8_t>& best = runs.size() < packed.size() ? runs : packed;
+        out.insert(out.end(), best.begin(), best.end());
+    }
+    out.insert(out.end(), Padding, 0);
+    return out;
+}
+
+// Упакованный блок читается по 8 байт без выравнивания: Padding в конце
+// данных гарантирует, что чтение не выходит за буфер
+bool GradeCodec::decode(const std::uint8_t* data, size_t size, double* grades, size_t count) {
+    if (size < Padding) return false;
+    const std::uint8_t* position = data;
+    const std::uint8_t* end = data + size - Padding;
+    for (size_t start = 0; start < count; start += BlockSize) {
+        size_t length = count - start < BlockSize ? count - start : BlockSize;
+        double* out = grades + start;
+        if (position >= end) return false;
+        std::uint8_t mode = *position++;
+
+        if (mode == Raw) {
+            if (static_cast<size_t>(end - position) < length * sizeof(double)) return false;
+            std::memcpy(out, position, length * sizeof(double));
+            position += length * sizeof(double);
+        }
+        else if (mode == Packed) {
+            if (end - position < 2) return false;
+            std::uint8_t base = position[0];
+            unsigned width = position[1];
+            position += 2;
+            if (width > 8 || base > 50) return false;
+            size_t bytes = (length * width + 7) / 8;
+            if (static_cast<size_t>(end - position) < bytes) return false;
+            const double* table = gradeTable.values + base;
+            if (width == 0) {
+                std::fill(out, out + length, table[0]);
+                continue;
+            }
+            std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+            size_t bit = 0;
+            for (size_t i = 0; i < length; ++i, bit += width) {
+                std::uint64_t word;
+                std::memcpy(&word, position + (bit >> 3), sizeof(word));
+                unsigned code = static_cast<unsigned>((word >> (bit & 7)) & mask);
+                if (base + code > 255) return false;
+                out[i] = table[code];
+            }
+            position += bytes;
+        }
+        else if (mode == Runs) {
+            size_t filled = 0;
+            while (filled < length) {
+                if (end - position < 2) return false;
+                std::uint8_t code = position[0];
+                size_t run = position[1];
+                position += 2;
+                if (run == 0 || run > length - filled) return false;
+                std::fill(out + filled, out + filled + run, gradeTable.values[code]);
+                filled += run;
+            }
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef GRADECODEC_HPP
+#define GRADECODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Сжатие колонки оценок для файла группы. Оценки кратны 0.1, поэтому
+// хранятся кодами 0..50 (оценка * 10). Колонка режется на блоки по
+// BlockSize оценок, каждый блок кодируется самым коротким из способов:
+//   Packed - минимальный код блока + коды минус минимум по width бит;
+//   Runs   - пары (код, длина серии) для повторяющихся оценок;
+//   Raw    - исходные double, если в блоке есть оценка не кратная 0.1.
+// В конце данных - Padding нулевых байт, чтобы декодер читал по 8 байт
+class GradeCodec {
+public:
+    static const size_t BlockSize = 128;
+    static const size_t Padding = 8;
+
+private:
+    enum Mode : std::uint8_t { Raw = 0, Packed = 1, Runs = 2 };
+
+    static bool toCodes(const double* grades, size_t count, std::uint8_t* codes);
+    static void encodePacked(const std::uint8_t* codes, size_t count, std::vector<std::uint8_t>& out);
+    static void encodeRuns(const std::uint8_t* codes, size_t count, std::vector<std::uint8_t>& out);
+
+public:
+    static std::vector<std::uint8_t> encode(const double* grades, size_t count);
+
+    // false, если данные повреждены или закончились раньше count оценок
+    static bool decode(const std::uint8_t* data, size_t size, double* grades, size_t count);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "GradeHistogram.hpp"
+#include <cmath>
+
+int GradeHistogram::bucketOf(double grade) {
+    long index = std::lround(grade * 10.0);
+    if (index < 0) return 0;
+    if (index >= BucketCount) return BucketCount - 1;
+    return static_cast<int>(index);
+}
+
+// rank считается с единицы
+double GradeHistogram::valueAtRank(size_t rank) const {
+    size_t seen = 0;
+    for (int i = 0; i < BucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) return getBucketValue(i);
+    }
+    return getBucketValue(BucketCount - 1);
+}
+
+GradeHistogram::GradeHistogram() : total(0) {
+    clear();
+}
+
+void GradeHistogram::add(double grade) {
+    ++buckets[bucketOf(grade)];
+    ++total;
+}
+
+void GradeHistogram::remove(double grade) {
+    int index = bucketOf(grade);
+    if (buckets[index] == 0) return;
+    --buckets[index];
+    --total;
+}
+
+void GradeHistogram::merge(const GradeHistogram& other) {
+    for (int i = 0; i < BucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    total += other.total;
+}
+
+void GradeHistogram::subtract(const GradeHistogram& other) {
+    for (int i = 0; i < BucketCount; ++i) {
+        buckets[i] -= other.buckets[i];
+    }
+    total -= other.total;
+}
+
+void GradeHistogram::clear() {
+    for (int i = 0; i < BucketCount; ++i) {
+        buckets[i] = 0;
+    }
+    total = 0;
+}
+
+size_t GradeHistogram::getCount() const { return total; }
+std::uint32_t GradeHistogram::getBucket(int index) const { return buckets[index]; }
+double GradeHistogram::getBucketValue(int index) { return index / 10.0; }
+
+double GradeHistogram::getMedian() const {
+    if (total == 0) return 0.0;
+    if (total % 2 == 1) return valueAtRank(total / 2 + 1);
+    return (valueAtRank(total / 2) + valueAtRank(total / 2 + 1)) / 2.0;
+}
+
+// Процентиль по методу ближайшего ранга, percent в диапазоне [0, 100]
+double GradeHistogram::getPercentile(double percent) const {
+    if (total == 0) return 0.0;
+    if (percent < 0.0) percent = 0.0;
+    if (percent > 100.0) percent = 100.0;
+    size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * total));
+    if (rank == 0) rank = 1;
+    return valueAtRank(rank);
+}
+
+double GradeHistogram::getMode() const {
+    if (total == 0) return 0.0;
+    int best = 0;
+    for (int i = 1; i < BucketCount; ++i) {
+        if (buckets[i] > buckets[best]) best = i;
+    }
+    return getBucketValue(best);
+}
\ No newline at end of file
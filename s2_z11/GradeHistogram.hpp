@@ -0,0 +1,40 @@
+#ifndef GRADEHISTOGRAM_HPP
+#define GRADEHISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+// Гистограмма оценок шкалы 0..5 с корзинами по 0.1. Медиана, процентили и
+// мода считаются проходом по корзинам без сортировки и копирования оценок
+class GradeHistogram {
+public:
+    static const int BucketCount = 51;
+
+private:
+    std::uint32_t buckets[BucketCount];
+    size_t total;
+
+    static int bucketOf(double grade);
+    double valueAtRank(size_t rank) const;
+
+public:
+    GradeHistogram();
+
+    void add(double grade);
+    void remove(double grade);
+    void merge(const GradeHistogram& other);
+    void subtract(const GradeHistogram& other);
+    void clear();
+
+    size_t getCount() const;
+    std::uint32_t getBucket(int index) const;
+    static double getBucketValue(int index);
+
+    double getMedian() const;
+    double getPercentile(double percent) const;
+    double getMode() const;
+
+    inline bool isEmpty() const { return total == 0; }
+};
+
+#endif
\ No newline at end of file
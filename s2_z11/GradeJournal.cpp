@@ -0,0 +1,534 @@
+#include "GradeJournal.hpp"
+#include "FileManager.hpp"
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+// Заголовок журнала: сигнатура и версия. Запись: длина и контрольная
+// сумма содержимого, затем код операции, имя и данные операции
+static const char JournalHeader[8] = { 'G', 'J', 'N', '1', 1, 0, 0, 0 };
+static const size_t RecordHeaderSize = 2 * sizeof(std::uint32_t);
+
+#ifdef _WIN32
+static void* const NoFile = INVALID_HANDLE_VALUE;
+
+static void* openForAppend(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) SetFilePointer(file, 0, nullptr, FILE_END);
+    return file;
+}
+
+static bool writeAll(void* file, const char* data, size_t size) {
+    while (size > 0) {
+        DWORD chunk = size > 0x40000000 ? 0x40000000 : static_cast<DWORD>(size);
+        DWORD written = 0;
+        if (!WriteFile(file, data, chunk, &written, nullptr)) return false;
+        data += written;
+        size -= written;
+    }
+    return true;
+}
+
+static bool syncFile(void* file) { return FlushFileBuffers(file) != 0; }
+static void closeFile(void* file) { CloseHandle(file); }
+
+static bool syncPath(const std::string& path) {
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    bool synced = FlushFileBuffers(file) != 0;
+    CloseHandle(file);
+    return synced;
+}
+
+// Каталог на Windows не синхронизируется отдельно
+static void syncDirectory(const std::string&) {}
+#else
+static const int NoFile = -1;
+
+static int openForAppend(const std::string& path) {
+    return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+}
+
+static bool writeAll(int file, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(file, data, size);
+        if (written < 0) return false;
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+static bool syncFile(int file) { return ::fsync(file) == 0; }
+static void closeFile(int file) { ::close(file); }
+
+static bool syncPath(const std::string& path) {
+    int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) return false;
+    bool synced = ::fsync(file) == 0;
+    ::close(file);
+    return synced;
+}
+
+// Переименование и создание файла долговечны только после fsync каталога
+static void syncDirectory(const std::string& path) {
+    std::filesystem::path directory = std::filesystem::path(path).parent_path();
+    syncPath(directory.empty() ? std::string(".") : directory.string());
+}
+#endif
+
+static bool replaceFile(const std::string& from, const std::string& to) {
+    std::error_code error;
+    std::filesystem::rename(from, to, error);
+    if (error) return false;
+    syncDirectory(to);
+    return true;
+}
+
+// FNV-1a: отличает недописанный хвост от целой записи
+static std::uint32_t checksum(const char* data, size_t size) {
+    std::uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<std::uint8_t>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static void putBytes(std::vector<char>& buffer, const void* data, size_t size) {
+    const char* bytes = static_cast<const char*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+static void putString(std::vector<char>& buffer, const std::string& str) {
+    std::uint32_t length = static_cast<std::uint32_t>(str.size());
+    putBytes(buffer, &length, sizeof(length));
+    putBytes(buffer, str.data(), str.size());
+}
+
+static bool getBytes(const char* data, size_t size, size_t& position, void* out, size_t count) {
+    if (count > size - position) return false;
+    memcpy(out, data + position, count);
+    position += count;
+    return true;
+}
+
+static bool getString(const char* data, size_t size, size_t& position, std::string& str) {
+    std::uint32_t length = 0;
+    if (!getBytes(data, size, position, &length, sizeof(length)) || length > size - position) {
+        return false;
+    }
+    str.assign(data + position, length);
+    position += length;
+    return true;
+}
+
+GradeJournal::GradeJournal()
+    : journal(NoFile), appendedSequence(0), durableSequence(0), journalSize(0), syncCount(0),
+    flushing(false), opened(false), failed(false), compacting(false), rotated(false) {
+}
+
+GradeJournal::~GradeJournal() { close(); }
+
+bool GradeJournal::applyEnroll(const std::string& name, const std::string& recordNumber) {
+    if (group.contains(name)) return false;
+    group.addStudent(store.get(store.create(name, recordNumber)));
+    return true;
+}
+
+bool GradeJournal::applyExpel(const std::string& name) {
+    Student* student = group.findStudent(name);
+    if (!student) return false;
+    group.removeStudent(name);
+    store.destroy(store.handleOf(student));
+    return true;
+}
+
+bool GradeJournal::applyGrade(const std::string& name, double grade) {
+    Student* student = group.findStudent(name);
+    return student && student->addGrade(grade);
+}
+
+void GradeJournal::Roster::add(Student* student) {
+    students.push_back(student);
+    byName.emplace(student->getName(), student);
+}
+
+bool GradeJournal::Roster::applyEnroll(const std::string& name, const std::string& recordNumber) {
+    if (byName.count(name)) return false;
+    add(store.get(store.create(name, recordNumber)));
+    return true;
+}
+
+// Как Group::findStudent, по имени находится первый из тёзок
+bool GradeJournal::Roster::applyExpel(const std::string& name) {
+    auto found = byName.find(name);
+    if (found == byName.end()) return false;
+    Student* student = found->second;
+    byName.erase(found);
+    students.erase(std::find(students.begin(), students.end(), student));
+    for (auto* other : students) {
+        if (other->getName() == name) {
+            byName.emplace(name, other);
+            break;
+        }
+    }
+    store.destroy(store.handleOf(student));
+    return true;
+}
+
+bool GradeJournal::Roster::applyGrade(const std::string& name, double grade) {
+    auto found = byName.find(name);
+    return found != byName.end() && found->second->addGrade(grade);
+}
+
+template <typename Target>
+bool GradeJournal::apply(Target& target, const char* payload, size_t size) {
+    size_t position = 1;
+    std::string name;
+    if (size < 1 || !getString(payload, size, position, name)) return false;
+
+    bool applied = false;
+    switch (static_cast<Operation>(payload[0])) {
+    case Operation::Enroll: {
+        std::string recordNumber;
+        applied = getString(payload, size, position, recordNumber) &&
+            target.applyEnroll(name, recordNumber);
+        break;
+    }
+    case Operation::Expel:
+        applied = target.applyExpel(name);
+        break;
+    case Operation::AddGrade: {
+        double grade = 0.0;
+        applied = getBytes(payload, size, position, &grade, sizeof(grade)) &&
+            target.applyGrade(name, grade);
+        break;
+    }
+    }
+    return applied && position == size;
+}
+
+void GradeJournal::append(Operation operation, const std::string& name,
+    const std::string& recordNumber, double grade) {
+    size_t start = pending.size();
+    pending.resize(start + RecordHeaderSize);
+    pending.push_back(static_cast<char>(operation));
+    putString(pending, name);
+    if (operation == Operation::Enroll) putString(pending, recordNumber);
+    if (operation == Operation::AddGrade) putBytes(pending, &grade, sizeof(grade));
+
+    std::uint32_t size = static_cast<std::uint32_t>(pending.size() - start - RecordHeaderSize);
+    std::uint32_t sum = checksum(pending.data() + start + RecordHeaderSize, size);
+    memcpy(pending.data() + start, &size, sizeof(size));
+    memcpy(pending.data() + start + sizeof(size), &sum, sizeof(sum));
+    ++appendedSequence;
+}
+
+// Поток, не заставший идущую запись, становится ведущим и пишет весь
+// накопленный буфер, включая записи других потоков. Пока он ждёт fsync
+// без блокировки, остальные дописывают следующую пачку
+bool GradeJournal::commit(std::unique_lock<std::mutex>& lock, std::uint64_t sequence) {
+    while (durableSequence < sequence && !failed) {
+        if (flushing) {
+            flushed.wait(lock);
+            continue;
+        }
+        flushing = true;
+        writing.swap(pending);
+        std::uint64_t batchEnd = appendedSequence;
+        FileHandle target = journal;
+        lock.unlock();
+        bool written = writeAll(target, writing.data(), writing.size()) && syncFile(target);
+        lock.lock();
+        if (written) {
+            durableSequence = batchEnd;
+            journalSize += writing.size();
+            ++syncCount;
+        }
+        else {
+            std::cerr << "Error: Failed to write journal: " << journalFile << "\n";
+            failed = true;
+        }
+        writing.clear();
+        flushing = false;
+        flushed.notify_all();
+    }
+    return !failed;
+}
+
+// Чтение останавливается на первой недописанной или битой записи;
+// validSize - длина целой части файла
+template <typename Target>
+bool GradeJournal::replay(Target& target, const std::string& filename, size_t& validSize) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file for reading: " << filename << "\n";
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    file.close();
+
+    // Заголовок мог не дописаться, только если сбой был при создании файла
+    validSize = 0;
+    if (data.size() < sizeof(JournalHeader)) return true;
+    if (memcmp(data.data(), JournalHeader, sizeof(JournalHeader)) != 0) {
+        std::cerr << "Error: Invalid journal header: " << filename << "\n";
+        return false;
+    }
+
+    size_t position = sizeof(JournalHeader);
+    while (data.size() - position >= RecordHeaderSize) {
+        std::uint32_t size = 0;
+        std::uint32_t sum = 0;
+        memcpy(&size, data.data() + position, sizeof(size));
+        memcpy(&sum, data.data() + position + sizeof(size), sizeof(sum));
+        if (size > data.size() - position - RecordHeaderSize) break;
+        const char* payload = data.data() + position + RecordHeaderSize;
+        if (checksum(payload, size) != sum) break;
+        if (!apply(target, payload, size)) {
+            std::cerr << "Error: Journal does not match the snapshot: " << filename << "\n";
+            return false;
+        }
+        position += RecordHeaderSize + size;
+    }
+    validSize = position;
+    return true;
+}
+
+// Новый снимок пишется рядом и становится на место, только когда
+// целиком на диске. journal.old без snapshot.tmp означает, что снимок
+// уже установлен и старый журнал в нём учтён
+bool GradeJournal::installSnapshot(const std::vector<Student*>& students,
+    const std::string& groupName) {
+    std::string temporary = snapshotFile + ".tmp";
+    std::string oldJournal = journalFile + ".old";
+    if (!FileManager::writeStudents(students, groupName, temporary) || !syncPath(temporary) ||
+        !replaceFile(journalFile, oldJournal) || !replaceFile(temporary, snapshotFile)) {
+        std::cerr << "Error: Cannot install snapshot: " << snapshotFile << "\n";
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::remove(oldJournal, error);
+    return true;
+}
+
+bool GradeJournal::recover(const std::string& groupName) {
+    std::string temporary = snapshotFile + ".tmp";
+    std::string oldJournal = journalFile + ".old";
+    std::string nextJournal = journalFile + ".new";
+    std::error_code error;
+
+    // Сбой между записью снимка и его установкой: доводим до конца
+    if (std::filesystem::exists(oldJournal)) {
+        if (std::filesystem::exists(temporary) && !replaceFile(temporary, snapshotFile)) return false;
+        std::filesystem::remove(oldJournal, error);
+    }
+    else {
+        std::filesystem::remove(temporary, error);
+    }
+
+    group.setName(groupName);
+    if (std::filesystem::exists(snapshotFile) &&
+        !FileManager::loadGroup(group, store, snapshotFile)) {
+        return false;
+    }
+
+    size_t validSize = 0;
+    bool interrupted = std::filesystem::exists(nextJournal);
+    if (std::filesystem::exists(journalFile)) {
+        if (!replay(*this, journalFile, validSize)) return false;
+        // Уплотнение прервалось до установки снимка: состояние после
+        // старого журнала и есть тот снимок
+        if (interrupted && !installSnapshot(group.getStudents(), group.getName())) return false;
+    }
+    if (interrupted && (!replay(*this, nextJournal, validSize) || !replaceFile(nextJournal, journalFile))) {
+        return false;
+    }
+
+    if (std::filesystem::exists(journalFile)) {
+        std::filesystem::resize_file(journalFile, validSize, error);
+        if (error) return false;
+    }
+    journal = openForAppend(journalFile);
+    if (journal == NoFile) {
+        std::cerr << "Error: Cannot open file for writing: " << journalFile << "\n";
+        return false;
+    }
+    if (validSize == 0) {
+        if (!writeAll(journal, JournalHeader, sizeof(JournalHeader)) || !syncFile(journal)) return false;
+        syncDirectory(journalFile);
+        validSize = sizeof(JournalHeader);
+    }
+    journalSize = validSize;
+    return true;
+}
+
+bool GradeJournal::open(const std::string& snapshot, const std::string& journalName,
+    const std::string& groupName) {
+    close();
+    snapshotFile = snapshot;
+    journalFile = journalName;
+    if (!recover(groupName)) {
+        close();
+        return false;
+    }
+    opened = true;
+    return true;
+}
+
+// Операции возвращают управление только после своего fsync,
+// поэтому незаписанного буфера при закрытии не остаётся
+void GradeJournal::close() {
+    waitForCompaction();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (journal != NoFile) {
+        closeFile(journal);
+        journal = NoFile;
+    }
+    group.clear();
+    store.clear();
+    pending.clear();
+    appendedSequence = 0;
+    durableSequence = 0;
+    journalSize = 0;
+    syncCount = 0;
+    opened = false;
+    failed = false;
+    rotated = false;
+}
+
+bool GradeJournal::enrollStudent(const std::string& name, const std::string& recordNumber) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!opened || failed || !applyEnroll(name, recordNumber)) return false;
+    append(Operation::Enroll, name, recordNumber, 0.0);
+    return commit(lock, appendedSequence);
+}
+
+bool GradeJournal::expelStudent(const std::string& name) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!opened || failed || !applyExpel(name)) return false;
+    append(Operation::Expel, name, std::string(), 0.0);
+    return commit(lock, appendedSequence);
+}
+
+bool GradeJournal::addGrade(const std::string& name, double grade) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!opened || failed || !applyGrade(name, grade)) return false;
+    append(Operation::AddGrade, name, std::string(), grade);
+    return commit(lock, appendedSequence);
+}
+
+// Под блокировкой только переключение файла: всё, что попало в старый
+// журнал, уже есть на диске или в хвосте writing, поэтому снимок
+// собирается в фоне из файлов
+bool GradeJournal::startCompaction() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!opened || failed || compacting || rotated) return false;
+    if (compactor.joinable()) compactor.join();
+    while (flushing) flushed.wait(lock);
+
+    std::string nextJournal = journalFile + ".new";
+    std::error_code error;
+    std::filesystem::remove(nextJournal, error);
+    FileHandle next = openForAppend(nextJournal);
+    if (next == NoFile || !writeAll(next, JournalHeader, sizeof(JournalHeader)) || !syncFile(next)) {
+        if (next != NoFile) closeFile(next);
+        std::cerr << "Error: Cannot open file for writing: " << nextJournal << "\n";
+        return false;
+    }
+    syncDirectory(nextJournal);
+
+    // Незаписанный хвост относится к старому журналу и к снимку
+    FileHandle previous = journal;
+    journal = next;
+    journalSize = sizeof(JournalHeader);
+    writing.swap(pending);
+    flushing = true;
+    compacting = true;
+    rotated = true;
+    compactor = std::thread(&GradeJournal::compact, this, group.getName(), previous,
+        appendedSequence);
+    return true;
+}
+
+void GradeJournal::compact(std::string groupName, FileHandle previous, std::uint64_t cut) {
+    // Хвост дописывается до снимка: ждущие его потоки не ждут уплотнения
+    bool written = writeAll(previous, writing.data(), writing.size()) && syncFile(previous);
+    closeFile(previous);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (written) {
+            durableSequence = cut;
+            ++syncCount;
+        }
+        else {
+            std::cerr << "Error: Failed to write journal: " << journalFile << "\n";
+            failed = true;
+        }
+        writing.clear();
+        flushing = false;
+        flushed.notify_all();
+        if (!written) {
+            compacting = false;
+            return;
+        }
+    }
+
+    // Снимок и старый журнал меняет только этот поток, поэтому их можно
+    // читать без блокировки. Название берётся у группы, а не из снимка
+    Roster roster;
+    std::string loadedName;
+    size_t validSize = 0;
+    bool rebuilt = true;
+    if (std::filesystem::exists(snapshotFile)) {
+        std::vector<Student*> loaded;
+        rebuilt = FileManager::readStudents(roster.store, loaded, loadedName, snapshotFile);
+        for (auto* student : loaded) roster.add(student);
+    }
+    bool installed = rebuilt && replay(roster, journalFile, validSize) &&
+        installSnapshot(roster.students, groupName) &&
+        replaceFile(journalFile + ".new", journalFile);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    compacting = false;
+    if (installed) rotated = false;
+}
+
+void GradeJournal::waitForCompaction() {
+    if (compactor.joinable()) compactor.join();
+}
+
+size_t GradeJournal::getJournalSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return journalSize;
+}
+
+size_t GradeJournal::getSyncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncCount;
+}
+
+bool GradeJournal::isCompacting() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return compacting;
+}
+
+bool GradeJournal::hasFailed() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return failed;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#ifndef GRADEJOURNAL_HPP
+#define GRADEJOURNAL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Group.hpp"
+#include "StudentStore.hpp"
+
+// Журнал операций над группой поверх снимка GRP2. Каждая операция сразу
+// применяется к группе в памяти и дописывается в конец журнала; метод
+// возвращает управление, когда запись попала на диск. Одновременные
+// операции из разных потоков сбрасываются одним fsync (group commit):
+// первый дождавшийся поток пишет всё накопленное, остальные ждут его.
+//
+// Уплотнение под блокировкой только переключает запись на journal.new;
+// фоновый поток собирает новый снимок из прежнего снимка и отключённого
+// журнала, не трогая группу в памяти. Порядок переименований
+// (journal -> journal.old, snapshot.tmp -> snapshot, journal.new -> journal)
+// позволяет open восстановиться после сбоя на любом шаге
+class GradeJournal {
+public:
+    enum class Operation : std::uint8_t { Enroll = 1, Expel = 2, AddGrade = 3 };
+
+private:
+#ifdef _WIN32
+    using FileHandle = void*;
+#else
+    using FileHandle = int;
+#endif
+
+    std::string snapshotFile;
+    std::string journalFile;
+    StudentStore store;
+    Group group;
+
+    mutable std::mutex mutex;
+    std::condition_variable flushed;
+    FileHandle journal;
+    std::vector<char> pending;
+    std::vector<char> writing;
+    std::uint64_t appendedSequence;
+    std::uint64_t durableSequence;
+    size_t journalSize;
+    size_t syncCount;
+    bool flushing;
+    bool opened;
+    bool failed;
+
+    std::thread compactor;
+    bool compacting;
+    bool rotated;
+
+    // Состояние, которое собирает фоновое уплотнение: те же операции,
+    // что над группой, но без Group и её вывода в stdout
+    struct Roster {
+        StudentStore store;
+        std::vector<Student*> students;
+        std::unordered_map<std::string, Student*> byName;
+
+        void add(Student* student);
+        bool applyEnroll(const std::string& name, const std::string& recordNumber);
+        bool applyExpel(const std::string& name);
+        bool applyGrade(const std::string& name, double grade);
+    };
+
+    bool applyEnroll(const std::string& name, const std::string& recordNumber);
+    bool applyExpel(const std::string& name);
+    bool applyGrade(const std::string& name, double grade);
+
+    // Target - сам журнал или Roster
+    template <typename Target>
+    static bool apply(Target& target, const char* payload, size_t size);
+    template <typename Target>
+    static bool replay(Target& target, const std::string& filename, size_t& validSize);
+
+    void append(Operation operation, const std::string& name, const std::string& recordNumber,
+        double grade);
+    bool commit(std::unique_lock<std::mutex>& lock, std::uint64_t sequence);
+    bool recover(const std::string& groupName);
+    bool installSnapshot(const std::vector<Student*>& students, const std::string& groupName);
+    void compact(std::string groupName, FileHandle previous, std::uint64_t cut);
+
+public:
+    GradeJournal();
+    GradeJournal(const GradeJournal&) = delete;
+    GradeJournal& operator=(const GradeJournal&) = delete;
+    ~GradeJournal();
+
+    // Загружает снимок (если есть) и проигрывает журнал. groupName
+    // используется, когда снимка ещё нет
+    bool open(const std::string& snapshot, const std::string& journalName,
+        const std::string& groupName = "");
+    void close();
+
+    // false, если операция неприменима или запись не удалось сохранить
+    bool enrollStudent(const std::string& name, const std::string& recordNumber);
+    bool expelStudent(const std::string& name);
+    bool addGrade(const std::string& name, double grade);
+
+    // Запускает фоновое уплотнение; false, если оно уже идёт.
+    // Вызывается из того же потока, что open и close
+    bool startCompaction();
+    void waitForCompaction();
+
+    // visitor(const Group&) под блокировкой журнала
+    template <typename Visitor>
+    void inspect(Visitor visitor) const {
+        std::lock_guard<std::mutex> lock(mutex);
+        visitor(static_cast<const Group&>(group));
+    }
+
+    size_t getJournalSize() const;
+    size_t getSyncCount() const;
+    bool isCompacting() const;
+    bool hasFailed() const;
+
+    inline bool isOpen() const { return opened; }
+};
+
+#endif
\ No newline at end of file
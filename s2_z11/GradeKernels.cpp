@@ -0,0 +1,170 @@
+#include "GradeKernels.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(_M_IX86) || defined(__i386__)
+#define GRADE_KERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(GRADE_KERNELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GRADE_TARGET_SSE2 __attribute__((target("sse2")))
+#define GRADE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define GRADE_TARGET_SSE2
+#define GRADE_TARGET_AVX2
+#endif
+
+namespace {
+
+IngestResult compactScalar(const double* src, size_t count, double* dst) {
+    IngestResult result = { 0, 0 };
+    for (size_t i = 0; i < count; ++i) {
+        double grade = src[i];
+        if (grade >= 0 && grade <= 5) dst[result.accepted++] = grade;
+    }
+    result.rejected = count - result.accepted;
+    return result;
+}
+
+#ifdef GRADE_KERNELS_X86
+
+// Для каждой 4-битной маски допустимых полос - индексы 32-битных половин,
+// которые нужно сдвинуть в начало регистра
+constexpr std::array<std::array<std::int32_t, 8>, 16> makeCompactTable() {
+    std::array<std::array<std::int32_t, 8>, 16> table{};
+    for (int mask = 0; mask < 16; ++mask) {
+        int out = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            if (mask & (1 << lane)) {
+                table[mask][out++] = lane * 2;
+                table[mask][out++] = lane * 2 + 1;
+            }
+        }
+    }
+    return table;
+}
+
+alignas(32) constexpr std::array<std::array<std::int32_t, 8>, 16> compactTable = makeCompactTable();
+
+GRADE_TARGET_SSE2 IngestResult compactSSE2(const double* src, size_t count, double* dst) {
+    const __m128d low = _mm_set1_pd(0.0);
+    const __m128d high = _mm_set1_pd(5.0);
+    size_t accepted = 0;
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2) {
+        __m128d value = _mm_loadu_pd(src + i);
+        __m128d valid = _mm_and_pd(_mm_cmpge_pd(value, low), _mm_cmple_pd(value, high));
+
+        int mask = _mm_movemask_pd(valid);
+        if (mask == 2) value = _mm_unpackhi_pd(value, value);
+        _mm_storeu_pd(dst + accepted, value);
+        accepted += static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+
+    IngestResult tail = compactScalar(src + i, count - i, dst + accepted);
+    IngestResult result = { accepted + tail.accepted, 0 };
+    result.rejected = count - result.accepted;
+    return result;
+}
+
+GRADE_TARGET_AVX2 IngestResult compactAVX2(const double* src, size_t count, double* dst) {
+    const __m256d low = _mm256_set1_pd(0.0);
+    const __m256d high = _mm256_set1_pd(5.0);
+    size_t accepted = 0;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m256d value = _mm256_loadu_pd(src + i);
+        __m256d valid = _mm256_and_pd(_mm256_cmp_pd(value, low, _CMP_GE_OQ),
+            _mm256_cmp_pd(value, high, _CMP_LE_OQ));
+
+        int mask = _mm256_movemask_pd(valid);
+        __m256i order = _mm256_load_si256(
+            reinterpret_cast<const __m256i*>(compactTable[mask].data()));
+        __m256 packed = _mm256_permutevar8x32_ps(_mm256_castpd_ps(value), order);
+        _mm256_storeu_pd(dst + accepted, _mm256_castps_pd(packed));
+        accepted += static_cast<size_t>(std::popcount(static_cast<unsigned>(mask)));
+    }
+
+    IngestResult tail = compactScalar(src + i, count - i, dst + accepted);
+    IngestResult result = { accepted + tail.accepted, 0 };
+    result.rejected = count - result.accepted;
+    return result;
+}
+
+bool cpuHasSSE2() {
+#if defined(_M_X64) || defined(__x86_64__)
+    return true;
+#elif defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    return (info[3] & (1 << 26)) != 0;
+#else
+    return __builtin_cpu_supports("sse2");
+#endif
+}
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    if (!osSavesYmm) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif
+
+GradeKernels::Kernel detectKernel() {
+#ifdef GRADE_KERNELS_X86
+    if (cpuHasAVX2()) return GradeKernels::Kernel::AVX2;
+    if (cpuHasSSE2()) return GradeKernels::Kernel::SSE2;
+#endif
+    return GradeKernels::Kernel::Scalar;
+}
+
+}
+
+GradeKernels::Kernel GradeKernels::getActiveKernel() {
+    static const Kernel kernel = detectKernel();
+    return kernel;
+}
+
+const char* GradeKernels::getKernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::AVX2: return "AVX2";
+    case Kernel::SSE2: return "SSE2";
+    default: return "Scalar";
+    }
+}
+
+IngestResult GradeKernels::compactValid(const double* src, size_t count, double* dst) {
+    return compactValid(src, count, dst, getActiveKernel());
+}
+
+IngestResult GradeKernels::compactValid(const double* src, size_t count, double* dst,
+    Kernel kernel) {
+#ifdef GRADE_KERNELS_X86
+    if (kernel == Kernel::AVX2 && getActiveKernel() == Kernel::AVX2) {
+        return compactAVX2(src, count, dst);
+    }
+    if (kernel != Kernel::Scalar && getActiveKernel() != Kernel::Scalar) {
+        return compactSSE2(src, count, dst);
+    }
+#else
+    (void)kernel;
+#endif
+    return compactScalar(src, count, dst);
+}
\ No newline at end of file
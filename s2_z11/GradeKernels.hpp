@@ -0,0 +1,29 @@
+#ifndef GRADEKERNELS_HPP
+#define GRADEKERNELS_HPP
+
+#include <cstddef>
+
+struct IngestResult {
+    size_t accepted;
+    size_t rejected;
+};
+
+// Ядра пакетной загрузки оценок. Ядро выбирается один раз по возможностям
+// процессора (AVX2, SSE2), на остальных платформах работает скалярный вариант
+class GradeKernels {
+public:
+    enum class Kernel { Scalar, SSE2, AVX2 };
+
+    static Kernel getActiveKernel();
+    static const char* getKernelName(Kernel kernel);
+
+    // Копирует в dst только оценки из [0, 5], сохраняя порядок. Статистику
+    // зачётка считает сама тем же шагом, что в addGrade. В dst должно быть
+    // место на count + KernelSlack элементов: векторные ядра пишут полный регистр
+    static IngestResult compactValid(const double* src, size_t count, double* dst);
+    static IngestResult compactValid(const double* src, size_t count, double* dst, Kernel kernel);
+
+    static const size_t KernelSlack = 4;
+};
+
+#endif
\ No newline at end of file
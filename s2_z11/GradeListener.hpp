@@ -0,0 +1,27 @@
+#ifndef GRADELISTENER_HPP
+#define GRADELISTENER_HPP
+
+#include <string>
+
+class Student;
+
+// Подписчик на изменения оценок студента. onGradesChanging приходит до
+// изменения, onGradesChanged - после, так что подписчик может вычесть
+// старый вклад студента и добавить новый
+class GradeListener {
+public:
+    virtual ~GradeListener() {}
+
+    virtual void onGradesChanging(Student& student) = 0;
+    virtual void onGradesChanged(Student& student) = 0;
+    virtual void onStudentDestroyed(Student& student) = 0;
+    virtual void onStudentRenamed(Student& student, const std::string& oldName) {
+        (void)student;
+        (void)oldName;
+    }
+    // Студент переехал по новому адресу (перемещение, перестройка вектора).
+    // Приходит из noexcept-перемещения, поэтому не должен выделять память
+    virtual void onStudentMoved(Student& from, Student& to) = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef GRADEVIEW_HPP
+#define GRADEVIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+// Невладеющее представление оценок зачётки. Оценки хранятся либо как double,
+// либо как однобайтовые коды с шагом квантования и декодируются при чтении
+class GradeView {
+private:
+    const double* values;
+    const std::uint8_t* codes;
+    size_t count;
+    double step;
+
+public:
+    class iterator {
+    private:
+        const double* values;
+        const std::uint8_t* codes;
+        double step;
+        size_t index;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = double;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = double;
+
+        iterator() : values(nullptr), codes(nullptr), step(0.0), index(0) {}
+        iterator(const GradeView& view, size_t index)
+            : values(view.values), codes(view.codes), step(view.step), index(index) {
+        }
+
+        double operator*() const { return codes ? codes[index] * step : values[index]; }
+        iterator& operator++() { ++index; return *this; }
+        iterator operator++(int) { iterator old = *this; ++index; return old; }
+        bool operator==(const iterator& other) const { return index == other.index; }
+        bool operator!=(const iterator& other) const { return index != other.index; }
+    };
+
+    GradeView() : values(nullptr), codes(nullptr), count(0), step(0.0) {}
+    GradeView(const double* values, size_t count)
+        : values(values), codes(nullptr), count(count), step(0.0) {
+    }
+    GradeView(const std::uint8_t* codes, size_t count, double step)
+        : values(nullptr), codes(codes), count(count), step(step) {
+    }
+
+    double operator[](size_t index) const {
+        return codes ? codes[index] * step : values[index];
+    }
+
+    iterator begin() const { return iterator(*this, 0); }
+    iterator end() const { return iterator(*this, count); }
+
+    size_t size() const { return count; }
+    double front() const { return (*this)[0]; }
+    double back() const { return (*this)[count - 1]; }
+
+    std::vector<double> toVector() const { return std::vector<double>(begin(), end()); }
+
+    inline bool empty() const { return count == 0; }
+    inline bool isQuantized() const { return codes != nullptr; }
+};
+
+#endif
\ No newline at end of file
@@ -1,91 +1,553 @@
 #include "Group.hpp"
 #include <iostream>
 #include <iomanip>
+#include <utility>
+#include <unordered_set>
+#include <algorithm>
 
-Group::Group() : groupName("Unnamed Group") {}
+Group::Group() : groupName("Unnamed Group"), averageSum(0.0), columnsEnabled(false) {}
 
-Group::Group(const std::string& name) : groupName(name) {}
+Group::Group(std::string name)
+    : groupName(std::move(name)), averageSum(0.0), columnsEnabled(false) {
+}
+
+Group::Group(const Group& other)
+    : groupName(other.groupName), nameIndex(other.nameIndex), memberIds(other.memberIds),
+    positions(other.positions), freeIds(other.freeIds), averageSum(0.0),
+    columns(other.columns), columnsEnabled(other.columnsEnabled) {
+    students.reserve(other.students.size());
+    for (auto* student : other.students) {
+        students.push_back(student);
+        attach(student);
+    }
+}
+
+Group& Group::operator=(const Group& other) {
+    if (this != &other) {
+        clear();
+        groupName = other.groupName;
+        nameIndex = other.nameIndex;
+        memberIds = other.memberIds;
+        positions = other.positions;
+        freeIds = other.freeIds;
+        columns = other.columns;
+        columnsEnabled = other.columnsEnabled;
+        students.reserve(other.students.size());
+        for (auto* student : other.students) {
+            students.push_back(student);
+            attach(student);
+        }
+    }
+    return *this;
+}
+
+// Подписка переносится на новый объект группы, студенты не копируются
+Group::Group(Group&& other) noexcept
+    : groupName(std::move(other.groupName)), students(std::move(other.students)),
+    nameIndex(std::move(other.nameIndex)), memberIds(std::move(other.memberIds)),
+    positions(std::move(other.positions)), freeIds(std::move(other.freeIds)),
+    gradeHistogram(other.gradeHistogram),
+    averageRank(std::move(other.averageRank)), averageSum(other.averageSum),
+    columns(std::move(other.columns)), columnsEnabled(other.columnsEnabled),
+    membershipListeners(std::move(other.membershipListeners)) {
+    for (auto* student : students) {
+        student->replaceListener(&other, this);
+    }
+    other.students.clear();
+    other.clearIndex();
+    other.columns.clear();
+    other.resetAggregates();
+    other.membershipListeners.clear();
+    for (auto* listener : membershipListeners) {
+        listener->onGroupMoved(other, *this);
+    }
+}
+
+Group& Group::operator=(Group&& other) noexcept {
+    if (this != &other) {
+        clear();
+        groupName = std::move(other.groupName);
+        students = std::move(other.students);
+        nameIndex = std::move(other.nameIndex);
+        memberIds = std::move(other.memberIds);
+        positions = std::move(other.positions);
+        freeIds = std::move(other.freeIds);
+        gradeHistogram = other.gradeHistogram;
+        averageRank = std::move(other.averageRank);
+        averageSum = other.averageSum;
+        columns = std::move(other.columns);
+        columnsEnabled = other.columnsEnabled;
+        for (auto* student : students) {
+            student->replaceListener(&other, this);
+        }
+        other.students.clear();
+        other.clearIndex();
+        other.columns.clear();
+        other.resetAggregates();
+
+        // Прежние подписчики этой группы видят её исчезновение
+        std::vector<MembershipListener*> previous;
+        previous.swap(membershipListeners);
+        for (auto* listener : previous) {
+            listener->onGroupDestroyed(*this);
+        }
+        membershipListeners = std::move(other.membershipListeners);
+        other.membershipListeners.clear();
+        for (auto* listener : membershipListeners) {
+            listener->onGroupMoved(other, *this);
+        }
+    }
+    return *this;
+}
 
 Group::~Group() {
+    for (auto* student : students) {
+        student->unsubscribe(this);
+    }
+    std::vector<MembershipListener*> current;
+    current.swap(membershipListeners);
+    for (auto* listener : current) {
+        listener->onGroupDestroyed(*this);
+    }
     std::cout << "Group " << groupName << " destroyed\n";
 }
 
+// Группа подписывается на каждого участника, чтобы гистограмма и агрегаты
+// по средним баллам оставались актуальными при любом изменении зачётки
+void Group::attach(Student* student) {
+    student->subscribe(this);
+    addContribution(student);
+    for (auto* listener : membershipListeners) {
+        listener->onStudentJoined(*this, *student);
+    }
+}
+
+void Group::detach(Student* student) {
+    removeContribution(student);
+    student->unsubscribe(this);
+}
+
+void Group::addContribution(Student* student) {
+    double average = student->getAverage();
+    gradeHistogram.merge(student->getHistogram());
+    averageRank.insert(average, student);
+    averageSum += average;
+}
+
+// Вызывается, пока средний балл студента ещё прежний
+void Group::removeContribution(Student* student) {
+    double average = student->getAverage();
+    gradeHistogram.subtract(student->getHistogram());
+    averageRank.erase(average, student);
+    averageSum -= average;
+    if (averageRank.empty()) averageSum = 0.0;
+}
+
+// Вызывается после удаления вхождения, когда индекс уже согласован
+void Group::notifyLeft(Student* student) {
+    if (membershipListeners.empty() || findSlot(student) < students.size()) return;
+    for (auto* listener : membershipListeners) {
+        listener->onStudentLeft(*this, *student);
+    }
+}
+
+void Group::resetAggregates() {
+    gradeHistogram.clear();
+    averageRank.clear();
+    averageSum = 0.0;
+}
+
+// Каждому вхождению студента выдаётся номер участника: имя ведёт к номеру,
+// positions - от номера к позиции в students. Одно имя может встречаться
+// несколько раз. Освободившиеся номера используются повторно
+void Group::indexSlot(size_t slot) {
+    size_t id;
+    if (!freeIds.empty()) {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else {
+        id = positions.size();
+        positions.push_back(0);
+        // Выход студента из группы не должен выделять память
+        if (freeIds.capacity() < positions.capacity()) freeIds.reserve(positions.capacity());
+    }
+    positions[id] = slot;
+    if (memberIds.size() <= slot) memberIds.resize(slot + 1);
+    memberIds[slot] = id;
+    nameIndex.emplace(students[slot]->getName(), id);
+}
+
+void Group::unindexSlot(size_t slot) {
+    size_t id = memberIds[slot];
+    auto range = nameIndex.equal_range(students[slot]->getName());
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == id) {
+            nameIndex.erase(it);
+            break;
+        }
+    }
+    freeIds.push_back(id);
+}
+
+// После сдвига или перестановки обновляются только позиции, хеш не трогается
+void Group::renumberFrom(size_t slot) {
+    for (size_t i = slot; i < memberIds.size(); ++i) {
+        positions[memberIds[i]] = i;
+    }
+}
+
+// Первая по порядку позиция студента с таким именем
+size_t Group::findSlot(std::string_view name) const {
+    size_t best = students.size();
+    auto range = nameIndex.equal_range(name);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (positions[it->second] < best) best = positions[it->second];
+    }
+    return best;
+}
+
+size_t Group::findSlot(const Student* student) const {
+    size_t best = students.size();
+    auto range = nameIndex.equal_range(student->getName());
+    for (auto it = range.first; it != range.second; ++it) {
+        size_t slot = positions[it->second];
+        if (students[slot] == student && slot < best) best = slot;
+    }
+    return best;
+}
+
+// Удаление из середины сдвигает хвост: O(n) записей в positions без хеширования
+void Group::eraseSlot(size_t slot) {
+    unindexSlot(slot);
+    students.erase(students.begin() + slot);
+    memberIds.erase(memberIds.begin() + slot);
+    if (columnsEnabled) columns.erase(slot);
+    renumberFrom(slot);
+}
+
+void Group::swapEraseSlot(size_t slot) {
+    size_t last = students.size() - 1;
+    unindexSlot(slot);
+    if (slot != last) {
+        students[slot] = students[last];
+        memberIds[slot] = memberIds[last];
+        positions[memberIds[slot]] = slot;
+    }
+    students.pop_back();
+    memberIds.pop_back();
+    if (columnsEnabled) columns.swapErase(slot);
+}
+
+void Group::clearIndex() {
+    nameIndex.clear();
+    memberIds.clear();
+    positions.clear();
+    freeIds.clear();
+}
+
+// Обновляет строки таблицы для всех вхождений студента. При присваивании
+// имя уже может быть другим - тогда строку обновит onStudentRenamed
+void Group::refreshColumns(const Student& student) {
+    auto range = nameIndex.equal_range(student.getName());
+    for (auto it = range.first; it != range.second; ++it) {
+        size_t slot = positions[it->second];
+        if (students[slot] == &student) columns.update(slot, student);
+    }
+}
+
+// order[i] - прежняя позиция студента, который встаёт на место i
+void Group::applyOrder(const std::vector<size_t>& order) {
+    std::vector<Student*> reordered(order.size());
+    std::vector<size_t> reorderedIds(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        reordered[i] = students[order[i]];
+        reorderedIds[i] = memberIds[order[i]];
+    }
+    students.swap(reordered);
+    memberIds.swap(reorderedIds);
+    if (columnsEnabled) columns.permute(order);
+    renumberFrom(0);
+}
+
+void Group::onGradesChanging(Student& student) {
+    removeContribution(&student);
+}
+
+void Group::onGradesChanged(Student& student) {
+    addContribution(&student);
+    if (columnsEnabled) refreshColumns(student);
+}
+
+// Удалённый студент сам выходит из группы, указатель не остаётся висячим
+void Group::onStudentDestroyed(Student& student) {
+    size_t slot = findSlot(&student);
+    if (slot < students.size()) {
+        removeContribution(&student);
+        eraseSlot(slot);
+        notifyLeft(&student);
+    }
+}
+
+// Вызывается один раз на каждое вхождение студента в группу
+void Group::onStudentRenamed(Student& student, const std::string& oldName) {
+    auto range = nameIndex.equal_range(oldName);
+    for (auto it = range.first; it != range.second; ++it) {
+        size_t slot = positions[it->second];
+        if (students[slot] == &student) {
+            auto node = nameIndex.extract(it);
+            node.key() = student.getName();
+            nameIndex.insert(std::move(node));
+            if (columnsEnabled) columns.update(slot, student);
+            return;
+        }
+    }
+}
+
+// Имя, оценки и позиция не меняются: достаточно переставить указатель
+// в слоте и в дереве рангов. Дерево берёт узел из списка свободных
+void Group::onStudentMoved(Student& from, Student& to) {
+    auto range = nameIndex.equal_range(to.getName());
+    for (auto it = range.first; it != range.second; ++it) {
+        size_t slot = positions[it->second];
+        if (students[slot] == &from) {
+            students[slot] = &to;
+            averageRank.erase(to.getAverage(), &from);
+            averageRank.insert(to.getAverage(), &to);
+            return;
+        }
+    }
+}
+
 void Group::addStudent(Student* student) {
     if (student) {
         students.push_back(student);
+        indexSlot(students.size() - 1);
+        attach(student);
+        if (columnsEnabled) columns.push(*student);
     }
 }
 
 void Group::addStudent(Student& student) {
-    students.push_back(&student);
+    addStudent(&student);
 }
 
-bool Group::removeStudent(const std::string& studentName) {
-    for (auto it = students.begin(); it != students.end(); ++it) {
-        if ((*it)->getName() == studentName) {
-            students.erase(it);
-            return true;
+size_t Group::addStudents(std::span<Student* const> batch, bool deduplicate) {
+    std::unordered_set<const Student*> present;
+    if (deduplicate) {
+        present.reserve(students.size() + batch.size());
+        present.insert(students.begin(), students.end());
+    }
+    size_t total = students.size() + batch.size();
+    students.reserve(total);
+    nameIndex.reserve(total);
+    memberIds.reserve(total);
+    averageRank.reserve(total);
+    if (columnsEnabled) columns.reserve(total);
+
+    // Рейтинг пополняется одним пакетом, поэтому подписчики узнают о
+    // новых участниках, когда пакет уже целиком в группе
+    size_t added = 0;
+    for (auto* student : batch) {
+        if (!student || (deduplicate && !present.insert(student).second)) continue;
+        students.push_back(student);
+        indexSlot(students.size() - 1);
+        student->subscribe(this);
+        gradeHistogram.merge(student->getHistogram());
+        averageSum += student->getAverage();
+        if (columnsEnabled) columns.push(*student);
+        ++added;
+    }
+    std::span<Student* const> joined(students.data() + students.size() - added, added);
+    averageRank.insertBatch(joined);
+    for (auto* student : joined) {
+        for (auto* listener : membershipListeners) {
+            listener->onStudentJoined(*this, *student);
         }
     }
-    return false;
+    return added;
 }
 
-void Group::clear() {
-    students.clear();
+// Все вхождения перечисленных студентов удаляются одним проходом
+size_t Group::removeStudents(std::span<Student* const> batch) {
+    if (batch.empty()) return 0;
+    std::unordered_set<const Student*> doomed(batch.begin(), batch.end());
+    return removeIf([&doomed](const Student& student) { return doomed.count(&student) != 0; });
 }
 
-double Group::calculateGroupAverage() const {
-    if (students.empty()) return 0.0;
+size_t Group::assignFrom(std::span<Student* const> batch, bool deduplicate) {
+    clear();
+    return addStudents(batch, deduplicate);
+}
 
-    double sum = 0.0;
-    for (const auto* student : students) {
-        sum += student->getAverage();
+size_t Group::mergeFrom(const Group& other, bool deduplicate) {
+    if (&other == this) {
+        std::vector<Student*> own = students;
+        return addStudents(own, deduplicate);
     }
-    return sum / students.size();
+    return addStudents(other.students, deduplicate);
 }
 
-Student* Group::findBestStudent() const {
-    if (students.empty()) return nullptr;
+bool Group::removeStudent(std::string_view studentName, RemoveMode mode) {
+    size_t slot = findSlot(studentName);
+    if (slot == students.size()) return false;
+    Student* student = students[slot];
+    detach(student);
+    if (mode == RemoveMode::SwapWithLast) swapEraseSlot(slot);
+    else eraseSlot(slot);
+    notifyLeft(student);
+    return true;
+}
 
-    Student* best = students[0];
+void Group::clear() {
     for (auto* student : students) {
-        if (student->getAverage() > best->getAverage()) {
-            best = student;
+        student->unsubscribe(this);
+    }
+    std::vector<Student*> former;
+    if (!membershipListeners.empty()) former = students;
+    students.clear();
+    clearIndex();
+    columns.clear();
+    resetAggregates();
+    for (auto* student : former) {
+        for (auto* listener : membershipListeners) {
+            listener->onStudentLeft(*this, *student);
         }
     }
-    return best;
 }
 
-void Group::sortStudentsByAverage() {
-    std::sort(students.begin(), students.end(),
-        [](const Student* a, const Student* b) {
-            return a->getAverage() > b->getAverage();
-        });
+// Агрегаты поддерживаются по уведомлениям студентов, запросы - O(1)
+double Group::calculateGroupAverage() const {
+    if (students.empty()) return 0.0;
+    return averageSum / students.size();
 }
 
-std::vector<Student*> Group::filterByThreshold(double threshold) const {
-    std::vector<Student*> result;
-    for (auto* student : students) {
-        if (student->getAverage() >= threshold) {
-            result.push_back(student);
+// Полный пересчёт по всем студентам, без погрешности, накопленной в averageSum
+double Group::calculateGroupAverage(Execution execution) const {
+    if (students.empty()) return 0.0;
+    double total = Parallel::reduce(students.size(), execution, 0.0,
+        [this](size_t begin, size_t end) {
+            if (columnsEnabled) return columns.sumAverages(begin, end);
+            double sum = 0.0;
+            for (size_t i = begin; i < end; ++i) sum += students[i]->getAverage();
+            return sum;
+        },
+        [](double a, double b) { return a + b; });
+    return total / students.size();
+}
+
+double Group::getHighestAverage() const { return averageRank.getHighest(); }
+double Group::getLowestAverage() const { return averageRank.getLowest(); }
+
+double Group::getMedianGrade() const { return gradeHistogram.getMedian(); }
+double Group::getGradePercentile(double percent) const {
+    return gradeHistogram.getPercentile(percent);
+}
+double Group::getModeGrade() const { return gradeHistogram.getMode(); }
+const GradeHistogram& Group::getGradeHistogram() const { return gradeHistogram; }
+
+Student* Group::findBestStudent() const { return averageRank.getBest(); }
+
+std::vector<Student*> Group::topK(size_t k) const { return averageRank.top(k); }
+std::vector<Student*> Group::bottomK(size_t k) const { return averageRank.bottom(k); }
+
+// Возвращает RankIndex::NotFound, если студента нет в группе
+size_t Group::rankOf(const Student* student) const {
+    if (!student) return RankIndex::NotFound;
+    return averageRank.rankOf(student->getAverage(), student);
+}
+
+Student* Group::studentAtRank(size_t rank) const { return averageRank.atRank(rank); }
+
+// k начинается с 1: kthBest(1) - лучший студент
+Student* Group::kthBest(size_t k) const { return k ? averageRank.atRank(k - 1) : nullptr; }
+
+std::vector<Student*> Group::findByAverageRange(double low, double high) const {
+    return averageRank.inRange(low, high);
+}
+
+// Рейтинг уже упорядочен с однозначной развязкой равных средних, поэтому
+// вместо сортировки - обход дерева за O(n). Повторы одного студента идут
+// в дереве подряд и занимают его позиции в прежнем порядке
+void Group::sortStudentsByAverage() {
+    std::vector<Student*> ranked = averageRank.inOrder();
+    std::vector<size_t> order;
+    order.reserve(students.size());
+    for (size_t i = 0; i < ranked.size(); ++i) {
+        if (i > 0 && ranked[i] == ranked[i - 1]) continue;
+        size_t first = order.size();
+        auto range = nameIndex.equal_range(ranked[i]->getName());
+        for (auto it = range.first; it != range.second; ++it) {
+            size_t slot = positions[it->second];
+            if (students[slot] == ranked[i]) order.push_back(slot);
         }
+        std::sort(order.begin() + first, order.end());
     }
-    return result;
+    applyOrder(order);
+}
+
+std::vector<Student*> Group::filterByThreshold(double threshold) const {
+    return where([threshold](const Student& student) {
+        return student.getAverage() >= threshold;
+        }).toVector();
+}
+
+// Каждый поток собирает свой кусок, куски склеиваются по порядку
+std::vector<Student*> Group::filterByThreshold(double threshold, Execution execution) const {
+    return Parallel::reduce(students.size(), execution, std::vector<Student*>(),
+        [this, threshold](size_t begin, size_t end) {
+            std::vector<Student*> part;
+            if (columnsEnabled) {
+                const double* averages = columns.getAverages();
+                for (size_t i = begin; i < end; ++i) {
+                    if (averages[i] >= threshold) part.push_back(students[i]);
+                }
+                return part;
+            }
+            for (size_t i = begin; i < end; ++i) {
+                if (students[i]->getAverage() >= threshold) part.push_back(students[i]);
+            }
+            return part;
+        },
+        [](std::vector<Student*> result, std::vector<Student*> part) {
+            result.insert(result.end(), part.begin(), part.end());
+            return result;
+        });
 }
 
 size_t Group::getStudentCount() const { return students.size(); }
+const std::vector<Student*>& Group::getStudents() const { return students; }
 
-bool Group::contains(const std::string& studentName) const {
-    for (const auto* student : students) {
-        if (student->getName() == studentName) {
-            return true;
-        }
-    }
-    return false;
+bool Group::contains(std::string_view studentName) const {
+    return nameIndex.find(studentName) != nameIndex.end();
+}
+
+Student* Group::findStudent(std::string_view studentName) const {
+    size_t slot = findSlot(studentName);
+    return slot < students.size() ? students[slot] : nullptr;
+}
+
+// Включение строит таблицу заново: id выдаются в текущем порядке студентов
+void Group::setColumnsEnabled(bool enabled) {
+    if (enabled == columnsEnabled) return;
+    columnsEnabled = enabled;
+    if (enabled) columns.rebuild(students);
+    else columns.clear();
+}
+
+const StudentColumns& Group::getColumns() const { return columns; }
+
+void Group::subscribeMembership(MembershipListener* listener) {
+    if (listener) membershipListeners.push_back(listener);
+}
+
+void Group::unsubscribeMembership(MembershipListener* listener) {
+    auto it = std::find(membershipListeners.begin(), membershipListeners.end(), listener);
+    if (it != membershipListeners.end()) membershipListeners.erase(it);
 }
 
-std::string Group::getName() const { return groupName; }
-void Group::setName(const std::string& newName) { groupName = newName; }
+const std::string& Group::getName() const { return groupName; }
+void Group::setName(std::string newName) { groupName = std::move(newName); }
 
 void Group::print() const {
     std::cout << "\n=== Group: " << groupName << " ===\n";
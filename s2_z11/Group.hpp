@@ -2,38 +2,191 @@
 #define GROUP_HPP
 
 #include <string>
+#include <string_view>
+#include <span>
 #include <vector>
+#include <unordered_map>
 #include <algorithm>
+#include <numeric>
 #include "Student.hpp"
+#include "GradeListener.hpp"
+#include "MembershipListener.hpp"
+#include "GradeHistogram.hpp"
+#include "RankIndex.hpp"
+#include "StudentRange.hpp"
+#include "Parallel.hpp"
+#include "StudentColumns.hpp"
 
-class Group {
+// Хеш по имени с поддержкой поиска по string_view без создания строки
+struct NameHash {
+    using is_transparent = void;
+    size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+};
+
+class Group : private GradeListener {
 private:
     std::string groupName;
+    // Участники - указатели, а не StudentHandle: в группе бывают и студенты
+    // не из StudentStore. Висячих указателей нет, потому что удалённый
+    // студент сам выходит из группы (onStudentDestroyed); дескриптор по
+    // указателю даёт StudentStore::handleOf
     std::vector<Student*> students;
+    // Имя -> номер участника. Номер не меняется при сдвигах, его позицию
+    // хранит positions, поэтому удаление из середины не трогает хеш
+    std::unordered_multimap<std::string, size_t, NameHash, std::equal_to<>> nameIndex;
+    std::vector<size_t> memberIds;
+    std::vector<size_t> positions;
+    std::vector<size_t> freeIds;
+    GradeHistogram gradeHistogram;
+    RankIndex averageRank;
+    double averageSum;
+    StudentColumns columns;
+    bool columnsEnabled;
+    std::vector<MembershipListener*> membershipListeners;
+
+    void attach(Student* student);
+    void detach(Student* student);
+    void addContribution(Student* student);
+    void removeContribution(Student* student);
+    void resetAggregates();
+    void notifyLeft(Student* student);
+
+    void indexSlot(size_t slot);
+    void unindexSlot(size_t slot);
+    void renumberFrom(size_t slot);
+    size_t findSlot(std::string_view name) const;
+    size_t findSlot(const Student* student) const;
+    void eraseSlot(size_t slot);
+    void swapEraseSlot(size_t slot);
+    void clearIndex();
+    void refreshColumns(const Student& student);
+    void applyOrder(const std::vector<size_t>& order);
+
+    void onGradesChanging(Student& student) override;
+    void onGradesChanged(Student& student) override;
+    void onStudentDestroyed(Student& student) override;
+    void onStudentRenamed(Student& student, const std::string& oldName) override;
+    void onStudentMoved(Student& from, Student& to) override;
 
 public:
+    // KeepOrder сдвигает хвост (O(n)), SwapWithLast ставит на место
+    // удалённого последнего студента (O(1)), порядок при этом меняется
+    enum class RemoveMode { KeepOrder, SwapWithLast };
+
     Group();
-    explicit Group(const std::string& name);
+    explicit Group(std::string name);
+    Group(const Group& other);
+    Group(Group&& other) noexcept;
+    Group& operator=(const Group& other);
+    Group& operator=(Group&& other) noexcept;
     ~Group();
 
     void addStudent(Student* student);
     void addStudent(Student& student);
-    bool removeStudent(const std::string& studentName);
+    bool removeStudent(std::string_view studentName, RemoveMode mode = RemoveMode::KeepOrder);
+
+    // Пакетные операции: память резервируется один раз на весь пакет.
+    // deduplicate пропускает уже состоящих в группе и повторы в пакете.
+    // Возвращают число добавленных/удалённых
+    size_t addStudents(std::span<Student* const> batch, bool deduplicate = false);
+    size_t removeStudents(std::span<Student* const> batch);
+    size_t assignFrom(std::span<Student* const> batch, bool deduplicate = false);
+    size_t mergeFrom(const Group& other, bool deduplicate = true);
+
+    // Удаляет всех студентов, для которых pred истинен, за один проход
+    // с уплотнением и сохранением порядка. Возвращает число удалённых
+    template <typename Predicate>
+    size_t removeIf(Predicate pred) {
+        std::vector<Student*> departed;
+        size_t kept = 0;
+        for (size_t i = 0; i < students.size(); ++i) {
+            Student* student = students[i];
+            if (pred(static_cast<const Student&>(*student))) {
+                detach(student);
+                unindexSlot(i);
+                if (!membershipListeners.empty()) departed.push_back(student);
+                continue;
+            }
+            if (kept != i) {
+                students[kept] = student;
+                memberIds[kept] = memberIds[i];
+                if (columnsEnabled) columns.move(i, kept);
+            }
+            ++kept;
+        }
+        size_t removed = students.size() - kept;
+        if (removed) {
+            students.resize(kept);
+            memberIds.resize(kept);
+            if (columnsEnabled) columns.truncate(kept);
+            renumberFrom(0);
+        }
+        for (auto* student : departed) {
+            notifyLeft(student);
+        }
+        return removed;
+    }
     void clear();
 
     double calculateGroupAverage() const;
+    double calculateGroupAverage(Execution execution) const;
+    double getHighestAverage() const;
+    double getLowestAverage() const;
+    double getMedianGrade() const;
+    double getGradePercentile(double percent) const;
+    double getModeGrade() const;
+    const GradeHistogram& getGradeHistogram() const;
     Student* findBestStudent() const;
 
+    // Рейтинг по среднему баллу, ранг 0 - лучший студент
+    std::vector<Student*> topK(size_t k) const;
+    std::vector<Student*> bottomK(size_t k) const;
+    size_t rankOf(const Student* student) const;
+    Student* studentAtRank(size_t rank) const;
+    Student* kthBest(size_t k) const;
+    std::vector<Student*> findByAverageRange(double low, double high) const;
+
     void sortStudentsByAverage();
     std::vector<Student*> filterByThreshold(double threshold) const;
+    std::vector<Student*> filterByThreshold(double threshold, Execution execution) const;
+
+    // Произвольный порядок студентов; крупные группы сортируются параллельно
+    template <typename Compare>
+    void sortStudents(Compare compare, Execution execution = Execution::Serial) {
+        std::vector<size_t> order(students.size());
+        std::iota(order.begin(), order.end(), size_t(0));
+        Parallel::sort(order.begin(), order.end(), execution,
+            [this, &compare](size_t a, size_t b) { return compare(*students[a], *students[b]); });
+        applyOrder(order);
+    }
+
+    // Ленивые запросы без промежуточных векторов, см. StudentRange.hpp
+    StudentRange<AnyStudent> all() const { return StudentRange<AnyStudent>(students, AnyStudent()); }
+
+    template <typename Predicate>
+    StudentRange<Predicate> where(Predicate pred) const {
+        return StudentRange<Predicate>(students, std::move(pred));
+    }
 
     size_t getStudentCount() const;
-    bool contains(const std::string& studentName) const;
-    std::string getName() const;
-    void setName(const std::string& newName);
+    const std::vector<Student*>& getStudents() const;
+    bool contains(std::string_view studentName) const;
+    Student* findStudent(std::string_view studentName) const;
+    const std::string& getName() const;
+    void setName(std::string newName);
 
     void print() const;
 
+    // Необязательная SoA-таблица горячих данных (см. StudentColumns).
+    // Пока включена, полные проходы читают её вместо студентов
+    void setColumnsEnabled(bool enabled);
+    const StudentColumns& getColumns() const;
+
+    // Подписки на состав группы не копируются вместе с группой
+    void subscribeMembership(MembershipListener* listener);
+    void unsubscribeMembership(MembershipListener* listener);
+
+    inline bool hasColumns() const { return columnsEnabled; }
     inline bool isEmpty() const { return students.empty(); }
 };
 
@@ -0,0 +1,54 @@
+#include "GroupSelection.hpp"
+#include <algorithm>
+#include <functional>
+#include <unordered_set>
+
+// В куче на вершине худший из отобранных: новый студент заменяет его,
+// только если стоит в рейтинге выше. Равные средние - по номеру создания,
+// затем по адресу, как в RankIndex
+std::vector<Student*> GroupSelection::select(const std::vector<const Group*>& groups,
+    size_t k, bool best) {
+    std::vector<Student*> heap;
+    if (k == 0) return heap;
+    auto ranksHigher = [best](const Student* a, const Student* b) {
+        double averageA = a->getAverage();
+        double averageB = b->getAverage();
+        if (averageA != averageB) return best ? averageA > averageB : averageA < averageB;
+        std::uint64_t sequenceA = a->getSequence();
+        std::uint64_t sequenceB = b->getSequence();
+        if (sequenceA != sequenceB) return best ? sequenceA < sequenceB : sequenceA > sequenceB;
+        return best ? std::greater<const Student*>()(a, b) : std::less<const Student*>()(a, b);
+    };
+
+    std::unordered_set<const Student*> seen;
+    for (const auto* group : groups) {
+        if (!group) continue;
+        for (auto* student : group->getStudents()) {
+            if (!seen.insert(student).second) continue;
+            if (heap.size() < k) {
+                heap.push_back(student);
+                std::push_heap(heap.begin(), heap.end(), ranksHigher);
+            }
+            else if (ranksHigher(student, heap.front())) {
+                std::pop_heap(heap.begin(), heap.end(), ranksHigher);
+                heap.back() = student;
+                std::push_heap(heap.begin(), heap.end(), ranksHigher);
+            }
+        }
+    }
+    std::sort_heap(heap.begin(), heap.end(), ranksHigher);
+    return heap;
+}
+
+std::vector<Student*> GroupSelection::topK(const std::vector<const Group*>& groups, size_t k) {
+    return select(groups, k, true);
+}
+
+std::vector<Student*> GroupSelection::bottomK(const std::vector<const Group*>& groups, size_t k) {
+    return select(groups, k, false);
+}
+
+Student* GroupSelection::kthBest(const std::vector<const Group*>& groups, size_t k) {
+    std::vector<Student*> best = select(groups, k, true);
+    return k > 0 && best.size() == k ? best.back() : nullptr;
+}
\ No newline at end of file
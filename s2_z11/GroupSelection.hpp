@@ -0,0 +1,25 @@
+#ifndef GROUPSELECTION_HPP
+#define GROUPSELECTION_HPP
+
+#include <cstddef>
+#include <vector>
+#include "Group.hpp"
+
+// Выбор лучших/худших студентов сразу по нескольким группам без сортировки
+// и без изменения порядка в группах: куча на k элементов, O(n log k).
+// Студент, состоящий в нескольких группах, учитывается один раз.
+// Для одной группы быстрее Group::topK/bottomK (индекс рейтинга)
+class GroupSelection {
+private:
+    static std::vector<Student*> select(const std::vector<const Group*>& groups, size_t k,
+        bool best);
+
+public:
+    static std::vector<Student*> topK(const std::vector<const Group*>& groups, size_t k);
+    static std::vector<Student*> bottomK(const std::vector<const Group*>& groups, size_t k);
+
+    // k-й лучший, начиная с 1; nullptr, если студентов меньше k
+    static Student* kthBest(const std::vector<const Group*>& groups, size_t k);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "GroupStreamReader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+GroupStreamReader::GroupStreamReader()
+    : header(), sections(), memoryBudget(DefaultBudget), nextStudent(0), failed(false),
+    recordCursor(0) {
+}
+
+bool GroupStreamReader::fail(const char* message) {
+    std::cerr << "Error: " << message << "\n";
+    failed = true;
+    return false;
+}
+
+// Четверть бюджета - под записи и представления пакета, остальное -
+// под оценки и строки. Имя и секции сверяются с размером файла до
+// выделения буферов: записи потом проверяются только по таблице секций
+bool GroupStreamReader::open(const std::string& filename, size_t budget) {
+    close();
+    memoryBudget = std::max(budget, (sizeof(StudentRecord) + sizeof(StudentView)) * 4);
+    file.open(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open file for reading: " << filename << "\n";
+        return false;
+    }
+    file.seekg(0, std::ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+
+    uint32_t nameLength = 0;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        memcmp(header.signature, "GRP2", 4) != 0 || header.version != 2 ||
+        !file.read(reinterpret_cast<char*>(&sections), sizeof(sections)) ||
+        !file.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength))) {
+        close();
+        return fail("Not an uncompressed GRP2 file");
+    }
+    uint64_t namePosition = sizeof(header) + sizeof(sections) + sizeof(nameLength);
+    uint64_t recordsSize = uint64_t(header.studentCount) * sizeof(StudentRecord);
+    if (nameLength > fileSize - namePosition ||
+        sections.recordsOffset > fileSize || recordsSize > fileSize - sections.recordsOffset ||
+        sections.gradesOffset > fileSize || sections.gradeCount > fileSize / sizeof(double) ||
+        sections.gradeCount * sizeof(double) > fileSize - sections.gradesOffset ||
+        sections.stringsOffset > fileSize || sections.stringsSize > fileSize - sections.stringsOffset) {
+        close();
+        return fail("Corrupted section table");
+    }
+    groupName.resize(nameLength);
+    if (nameLength && !file.read(&groupName[0], nameLength)) {
+        close();
+        return fail("Corrupted file header");
+    }
+
+    records.reserve(recordLimit());
+    grades.reserve(memoryBudget / 2 / sizeof(double));
+    strings.reserve(memoryBudget / 4);
+    return true;
+}
+
+void GroupStreamReader::close() {
+    if (file.is_open()) file.close();
+    file.clear();
+    groupName.clear();
+    header = FileHeader();
+    sections = SectionTable();
+    nextStudent = 0;
+    failed = false;
+    records.clear();
+    recordCursor = 0;
+}
+
+size_t GroupStreamReader::recordLimit() const {
+    return std::max<size_t>(1, memoryBudget / 4 / (sizeof(StudentRecord) + sizeof(StudentView)));
+}
+
+bool GroupStreamReader::refillRecords() {
+    size_t count = std::min(recordLimit(), static_cast<size_t>(header.studentCount) - nextStudent);
+    records.resize(count);
+    recordCursor = 0;
+    file.seekg(static_cast<std::streamoff>(sections.recordsOffset +
+        uint64_t(nextStudent) * sizeof(StudentRecord)));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(records.data()),
+        static_cast<std::streamsize>(count * sizeof(StudentRecord))));
+}
+
+bool GroupStreamReader::isValid(const StudentRecord& record) const {
+    return record.nameOffset <= sections.stringsSize &&
+        record.nameLength <= sections.stringsSize - record.nameOffset &&
+        record.numberOffset <= sections.stringsSize &&
+        record.numberLength <= sections.stringsSize - record.numberOffset &&
+        record.gradeOffset <= sections.gradeCount &&
+        record.gradeCount <= sections.gradeCount - record.gradeOffset;
+}
+
+// Пакет - самый длинный префикс оставшихся записей, чьи диапазоны оценок
+// и строк вместе помещаются в бюджет. Диапазоны читаются одним блоком каждый
+bool GroupStreamReader::nextBatch(std::vector<StudentView>& batch) {
+    batch.clear();
+    if (!file.is_open() || failed || nextStudent >= header.studentCount) return false;
+    if (recordCursor == records.size() && !refillRecords()) {
+        return fail("Failed to read student records");
+    }
+
+    size_t dataBudget = memoryBudget - memoryBudget / 4;
+    uint64_t gradeBegin = 0, gradeEnd = 0, stringBegin = 0, stringEnd = 0;
+    size_t taken = 0;
+    for (size_t i = recordCursor; i < records.size(); ++i) {
+        const StudentRecord& record = records[i];
+        if (!isValid(record)) return fail("Corrupted student record");
+        uint64_t newGradeBegin = taken ? std::min(gradeBegin, record.gradeOffset) : record.gradeOffset;
+        uint64_t newGradeEnd = std::max(taken ? gradeEnd : 0, record.gradeOffset + record.gradeCount);
+        uint64_t first = std::min(record.nameOffset, record.numberOffset);
+        uint64_t last = std::max(record.nameOffset + record.nameLength,
+            record.numberOffset + record.numberLength);
+        uint64_t newStringBegin = taken ? std::min(stringBegin, first) : first;
+        uint64_t newStringEnd = std::max(taken ? stringEnd : 0, last);
+        uint64_t needed = (newGradeEnd - newGradeBegin) * sizeof(double) +
+            (newStringEnd - newStringBegin);
+        if (taken && needed > dataBudget) break;
+        gradeBegin = newGradeBegin;
+        gradeEnd = newGradeEnd;
+        stringBegin = newStringBegin;
+        stringEnd = newStringEnd;
+        ++taken;
+    }
+
+    grades.resize(static_cast<size_t>(gradeEnd - gradeBegin));
+    strings.resize(static_cast<size_t>(stringEnd - stringBegin));
+    file.seekg(static_cast<std::streamoff>(sections.gradesOffset + gradeBegin * sizeof(double)));
+    file.read(reinterpret_cast<char*>(grades.data()),
+        static_cast<std::streamsize>(grades.size() * sizeof(double)));
+    file.seekg(static_cast<std::streamoff>(sections.stringsOffset + stringBegin));
+    if (!strings.empty()) file.read(&strings[0], static_cast<std::streamsize>(strings.size()));
+    if (!file) return fail("Failed to read student data");
+
+    batch.reserve(taken);
+    for (size_t i = recordCursor; i < recordCursor + taken; ++i) {
+        const StudentRecord& record = records[i];
+        batch.emplace_back(
+            std::string_view(strings.data() + (record.nameOffset - stringBegin), record.nameLength),
+            std::string_view(strings.data() + (record.numberOffset - stringBegin), record.numberLength),
+            GradeView(grades.data() + (record.gradeOffset - gradeBegin), record.gradeCount),
+            record.gradeStep);
+    }
+    recordCursor += taken;
+    nextStudent += taken;
+    return true;
+}
+
+size_t GroupStreamReader::getStudentCount() const { return header.studentCount; }
+const std::string& GroupStreamReader::getName() const { return groupName; }
+size_t GroupStreamReader::getMemoryBudget() const { return memoryBudget; }
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef GROUPSTREAMREADER_HPP
+#define GROUPSTREAMREADER_HPP
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "FileManager.hpp"
+#include "StudentView.hpp"
+
+// Потоковое чтение GRP2 пакетами в пределах заданного бюджета памяти:
+// буферы записей, оценок и строк выделяются один раз и не растут, поэтому
+// пиковое потребление памяти не зависит от размера файла. Представления
+// пакета действительны до следующего вызова nextBatch.
+// Студент, который один больше бюджета, всё равно читается отдельным пакетом
+class GroupStreamReader {
+public:
+    static const size_t DefaultBudget = 4 * 1024 * 1024;
+
+private:
+    std::ifstream file;
+    FileHeader header;
+    SectionTable sections;
+    std::string groupName;
+    size_t memoryBudget;
+    size_t nextStudent;
+    bool failed;
+
+    std::vector<StudentRecord> records;
+    size_t recordCursor;
+    std::vector<double> grades;
+    std::string strings;
+
+    size_t recordLimit() const;
+    bool refillRecords();
+    bool isValid(const StudentRecord& record) const;
+    bool fail(const char* message);
+
+public:
+    GroupStreamReader();
+
+    bool open(const std::string& filename, size_t budget = DefaultBudget);
+    void close();
+
+    // false, когда студенты закончились или файл повреждён (см. hasFailed)
+    bool nextBatch(std::vector<StudentView>& batch);
+
+    // visitor(const std::vector<StudentView>&) для каждого пакета
+    template <typename Visitor>
+    bool forEachBatch(Visitor visitor) {
+        std::vector<StudentView> batch;
+        while (nextBatch(batch)) visitor(static_cast<const std::vector<StudentView>&>(batch));
+        return !failed;
+    }
+
+    size_t getStudentCount() const;
+    const std::string& getName() const;
+    size_t getMemoryBudget() const;
+
+    inline bool isOpen() const { return file.is_open(); }
+    inline bool hasFailed() const { return failed; }
+};
+
+#endif
\ No newline at end of file
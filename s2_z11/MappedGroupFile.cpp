@@ -0,0 +1,149 @@
+#include "MappedGroupFile.hpp"
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedGroupFile::MappedGroupFile()
+    : data(nullptr), size(0), fileHandle(nullptr), mappingHandle(nullptr), header(nullptr),
+    sections(nullptr) {
+}
+#else
+MappedGroupFile::MappedGroupFile()
+    : data(nullptr), size(0), descriptor(-1), header(nullptr), sections(nullptr) {
+}
+#endif
+
+MappedGroupFile::~MappedGroupFile() { close(); }
+
+// Только заголовок и границы секций: записи проверяются при обращении
+bool MappedGroupFile::validate() {
+    if (size < sizeof(FileHeader) + sizeof(SectionTable) + sizeof(uint32_t)) return false;
+    header = reinterpret_cast<const FileHeader*>(data);
+    // Версия 3 (сжатые оценки) не отображается: оценки читаются как double напрямую
+    if (memcmp(header->signature, "GRP2", 4) != 0 || header->version != 2) return false;
+    sections = reinterpret_cast<const SectionTable*>(data + sizeof(FileHeader));
+
+    uint32_t nameLength;
+    size_t namePosition = sizeof(FileHeader) + sizeof(SectionTable);
+    memcpy(&nameLength, data + namePosition, sizeof(nameLength));
+    if (nameLength > size - namePosition - sizeof(nameLength)) return false;
+    groupName = std::string_view(data + namePosition + sizeof(nameLength), nameLength);
+
+    uint64_t recordsSize = uint64_t(header->studentCount) * sizeof(StudentRecord);
+    if (sections->recordsOffset > size || recordsSize > size - sections->recordsOffset ||
+        sections->gradesOffset > size || sections->gradeCount > size / sizeof(double) ||
+        sections->gradeCount * sizeof(double) > size - sections->gradesOffset ||
+        sections->stringsOffset > size || sections->stringsSize > size - sections->stringsOffset) {
+        return false;
+    }
+    // Оценки читаются как double прямо из отображения
+    return sections->gradesOffset % alignof(double) == 0;
+}
+
+bool MappedGroupFile::open(const std::string& filename) {
+    close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Error: Cannot open file for reading: " << filename << "\n";
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    const void* view = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping) view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    }
+    if (!view) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        std::cerr << "Error: Cannot map file: " << filename << "\n";
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    data = static_cast<const char*>(view);
+    size = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error: Cannot open file for reading: " << filename << "\n";
+        return false;
+    }
+    struct stat info;
+    void* view = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    }
+    if (view == MAP_FAILED) {
+        ::close(fd);
+        std::cerr << "Error: Cannot map file: " << filename << "\n";
+        return false;
+    }
+    descriptor = fd;
+    data = static_cast<const char*>(view);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!validate()) {
+        std::cerr << "Error: Invalid or corrupted GRP2 file: " << filename << "\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void MappedGroupFile::close() {
+    if (!data) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    munmap(const_cast<char*>(data), size);
+    ::close(descriptor);
+    descriptor = -1;
+#endif
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    sections = nullptr;
+    groupName = std::string_view();
+}
+
+size_t MappedGroupFile::getStudentCount() const { return header ? header->studentCount : 0; }
+std::string_view MappedGroupFile::getName() const { return groupName; }
+
+StudentView MappedGroupFile::getStudent(size_t index) const {
+    if (index >= getStudentCount()) return StudentView();
+    const StudentRecord& record = reinterpret_cast<const StudentRecord*>(
+        data + sections->recordsOffset)[index];
+    uint64_t stringsSize = sections->stringsSize;
+    if (record.nameOffset > stringsSize || record.nameLength > stringsSize - record.nameOffset ||
+        record.numberOffset > stringsSize ||
+        record.numberLength > stringsSize - record.numberOffset ||
+        record.gradeOffset > sections->gradeCount ||
+        record.gradeCount > sections->gradeCount - record.gradeOffset) {
+        return StudentView();
+    }
+    const char* strings = data + sections->stringsOffset;
+    const double* grades = reinterpret_cast<const double*>(data + sections->gradesOffset);
+    return StudentView(std::string_view(strings + record.nameOffset, record.nameLength),
+        std::string_view(strings + record.numberOffset, record.numberLength),
+        GradeView(grades + record.gradeOffset, record.gradeCount), record.gradeStep);
+}
\ No newline at end of file
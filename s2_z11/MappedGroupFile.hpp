@@ -0,0 +1,48 @@
+#ifndef MAPPEDGROUPFILE_HPP
+#define MAPPEDGROUPFILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include "FileManager.hpp"
+#include "StudentView.hpp"
+
+// Чтение GRP2 через отображение файла в память (mmap / MapViewOfFile).
+// open проверяет только заголовок и таблицу секций, поэтому занимает
+// одинаковое время для файла любого размера; страницы подгружаются
+// операционной системой при первом обращении к студенту
+class MappedGroupFile {
+private:
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int descriptor;
+#endif
+    const FileHeader* header;
+    const SectionTable* sections;
+    std::string_view groupName;
+
+    bool validate();
+
+public:
+    MappedGroupFile();
+    MappedGroupFile(const MappedGroupFile&) = delete;
+    MappedGroupFile& operator=(const MappedGroupFile&) = delete;
+    ~MappedGroupFile();
+
+    bool open(const std::string& filename);
+    void close();
+
+    size_t getStudentCount() const;
+    std::string_view getName() const;
+
+    // Пустое представление, если индекс или запись выходят за границы файла
+    StudentView getStudent(size_t index) const;
+
+    inline bool isOpen() const { return data != nullptr; }
+};
+
+#endif
\ No newline at end of file
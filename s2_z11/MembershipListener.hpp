@@ -0,0 +1,20 @@
+#ifndef MEMBERSHIPLISTENER_HPP
+#define MEMBERSHIPLISTENER_HPP
+
+class Group;
+class Student;
+
+// Подписчик на состав группы. onStudentLeft приходит, когда в группе не
+// осталось ни одного вхождения студента. Группа опознаётся по адресу;
+// при перемещении группы приходит onGroupMoved с прежним и новым адресом
+class MembershipListener {
+public:
+    virtual ~MembershipListener() {}
+
+    virtual void onStudentJoined(const Group& group, Student& student) = 0;
+    virtual void onStudentLeft(const Group& group, Student& student) = 0;
+    virtual void onGroupMoved(const Group& from, Group& to) = 0;
+    virtual void onGroupDestroyed(const Group& group) = 0;
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "MembershipRegistry.hpp"
+
+MembershipRegistry::MembershipRegistry() {}
+
+MembershipRegistry::~MembershipRegistry() {
+    for (auto* student : studentsById) {
+        if (student) student->unsubscribe(this);
+    }
+    for (auto& group : groups) {
+        group.first->unsubscribeMembership(this);
+    }
+}
+
+// id удалённого студента не выдаётся повторно, чтобы старые выборки
+// не указывали на другого человека
+void MembershipRegistry::onStudentDestroyed(Student& student) {
+    auto it = studentIds.find(&student);
+    if (it == studentIds.end()) return;
+    std::uint32_t id = it->second;
+    for (auto& group : groups) {
+        group.second.remove(id);
+    }
+    studentsById[id] = nullptr;
+    studentIds.erase(it);
+}
+
+// id сохраняется за студентом и после перемещения по новому адресу
+void MembershipRegistry::onStudentMoved(Student& from, Student& to) {
+    auto node = studentIds.extract(&from);
+    if (node.empty()) return;
+    node.key() = &to;
+    studentsById[node.mapped()] = &to;
+    studentIds.insert(std::move(node));
+}
+
+std::uint32_t MembershipRegistry::getStudentId(Student* student) {
+    if (!student) return NoId;
+    auto it = studentIds.find(student);
+    if (it != studentIds.end()) return it->second;
+    std::uint32_t id = static_cast<std::uint32_t>(studentsById.size());
+    studentIds.emplace(student, id);
+    studentsById.push_back(student);
+    student->subscribe(this);
+    return id;
+}
+
+std::uint32_t MembershipRegistry::findStudentId(const Student* student) const {
+    auto it = studentIds.find(student);
+    return it != studentIds.end() ? it->second : NoId;
+}
+
+Student* MembershipRegistry::getStudent(std::uint32_t id) const {
+    return id < studentsById.size() ? studentsById[id] : nullptr;
+}
+
+void MembershipRegistry::onStudentJoined(const Group& group, Student& student) {
+    auto it = groups.find(&group);
+    if (it != groups.end()) it->second.add(getStudentId(&student));
+}
+
+void MembershipRegistry::onStudentLeft(const Group& group, Student& student) {
+    auto it = groups.find(&group);
+    std::uint32_t id = findStudentId(&student);
+    if (it != groups.end() && id != NoId) it->second.remove(id);
+}
+
+// Группа перемещается внутри своего noexcept-перемещения: узел переносится
+// без выделения памяти
+void MembershipRegistry::onGroupMoved(const Group& from, Group& to) {
+    auto it = groups.find(&from);
+    if (it == groups.end()) return;
+    auto node = groups.extract(it);
+    node.key() = &to;
+    groups.insert(std::move(node));
+}
+
+void MembershipRegistry::onGroupDestroyed(const Group& group) {
+    auto it = groups.find(&group);
+    if (it != groups.end()) groups.erase(it);
+}
+
+// Начальный состав берётся сразу, дальше группа сообщает об изменениях сама
+void MembershipRegistry::watch(Group& group) {
+    if (groups.find(&group) != groups.end()) return;
+    StudentBitmap members;
+    for (auto* student : group.getStudents()) {
+        members.add(getStudentId(student));
+    }
+    groups.emplace(&group, std::move(members));
+    group.subscribeMembership(this);
+}
+
+bool MembershipRegistry::unwatch(Group& group) {
+    auto it = groups.find(&group);
+    if (it == groups.end()) return false;
+    groups.erase(it);
+    group.unsubscribeMembership(this);
+    return true;
+}
+
+bool MembershipRegistry::isWatching(const Group& group) const {
+    return groups.find(&group) != groups.end();
+}
+
+const StudentBitmap& MembershipRegistry::getMembers(const Group& group) const {
+    static const StudentBitmap none;
+    auto it = groups.find(&group);
+    return it != groups.end() ? it->second : none;
+}
+
+size_t MembershipRegistry::countGroupsOf(const Student* student) const {
+    std::uint32_t id = findStudentId(student);
+    if (id == NoId) return 0;
+    size_t count = 0;
+    for (const auto& group : groups) {
+        if (group.second.contains(id)) ++count;
+    }
+    return count;
+}
+
+std::vector<Student*> MembershipRegistry::resolve(const StudentBitmap& members) const {
+    std::vector<Student*> result;
+    result.reserve(members.cardinality());
+    for (std::uint32_t id : members.toVector()) {
+        if (Student* student = getStudent(id)) result.push_back(student);
+    }
+    return result;
+}
\ No newline at end of file
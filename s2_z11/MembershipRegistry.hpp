@@ -0,0 +1,66 @@
+#ifndef MEMBERSHIPREGISTRY_HPP
+#define MEMBERSHIPREGISTRY_HPP
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+#include "Group.hpp"
+#include "GradeListener.hpp"
+#include "MembershipListener.hpp"
+#include "StudentBitmap.hpp"
+
+// Реестр членства "многие ко многим": каждому студенту выдаётся плотный id,
+// для каждой наблюдаемой группы хранится StudentBitmap её участников.
+// Вопросы вида "в A и B, но не в C" решаются операциями над битовыми картами:
+//   (registry.getMembers(a) & registry.getMembers(b)).andNot(registry.getMembers(c))
+// После watch реестр подписан на группу и сам следит за её составом;
+// группы различаются по объекту, а не по имени. Удалённые студенты и
+// группы исключаются автоматически
+class MembershipRegistry : private GradeListener, private MembershipListener {
+private:
+    // Поиск группы по const Group* без снятия константности
+    struct GroupHash {
+        using is_transparent = void;
+        size_t operator()(const Group* group) const { return std::hash<const Group*>()(group); }
+    };
+
+    std::unordered_map<const Student*, std::uint32_t> studentIds;
+    std::vector<Student*> studentsById;
+    std::unordered_map<Group*, StudentBitmap, GroupHash, std::equal_to<>> groups;
+
+    void onGradesChanging(Student&) override {}
+    void onGradesChanged(Student&) override {}
+    void onStudentDestroyed(Student& student) override;
+    void onStudentMoved(Student& from, Student& to) override;
+
+    void onStudentJoined(const Group& group, Student& student) override;
+    void onStudentLeft(const Group& group, Student& student) override;
+    void onGroupMoved(const Group& from, Group& to) override;
+    void onGroupDestroyed(const Group& group) override;
+
+public:
+    static const std::uint32_t NoId = static_cast<std::uint32_t>(-1);
+
+    MembershipRegistry();
+    MembershipRegistry(const MembershipRegistry&) = delete;
+    MembershipRegistry& operator=(const MembershipRegistry&) = delete;
+    ~MembershipRegistry();
+
+    std::uint32_t getStudentId(Student* student);
+    std::uint32_t findStudentId(const Student* student) const;
+    Student* getStudent(std::uint32_t id) const;
+
+    void watch(Group& group);
+    bool unwatch(Group& group);
+    bool isWatching(const Group& group) const;
+    const StudentBitmap& getMembers(const Group& group) const;
+
+    size_t countGroupsOf(const Student* student) const;
+    std::vector<Student*> resolve(const StudentBitmap& members) const;
+
+    inline size_t getStudentCount() const { return studentIds.size(); }
+    inline size_t getGroupCount() const { return groups.size(); }
+};
+
+#endif
\ No newline at end of file
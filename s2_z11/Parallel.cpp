@@ -0,0 +1,31 @@
+#include "Parallel.hpp"
+#include <atomic>
+
+static std::atomic<size_t> parallelCutoff(65536);
+static std::atomic<size_t> parallelThreads(0);
+
+void Parallel::setCutoff(size_t elementCount) {
+    parallelCutoff.store(elementCount, std::memory_order_relaxed);
+}
+
+size_t Parallel::getCutoff() { return parallelCutoff.load(std::memory_order_relaxed); }
+
+void Parallel::setThreadCount(size_t threads) {
+    parallelThreads.store(threads, std::memory_order_relaxed);
+}
+
+size_t Parallel::getThreadCount() {
+    size_t threads = parallelThreads.load(std::memory_order_relaxed);
+    if (threads) return threads;
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware ? hardware : 1;
+}
+
+// Кусок не меньше половины порога, чтобы каждый поток получал заметную работу
+size_t Parallel::chunkCount(size_t count, Execution execution) {
+    size_t cutoff = getCutoff();
+    if (execution == Execution::Serial || count < cutoff || count < 2) return 1;
+    size_t minChunk = cutoff / 2 > 0 ? cutoff / 2 : 1;
+    size_t chunks = count / minChunk;
+    return std::max<size_t>(1, std::min(chunks, getThreadCount()));
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class Execution { Serial, Parallel };
+
+// Разбиение работы на куски по потокам. Ниже порога (по умолчанию 65536
+// элементов) и в режиме Serial всё выполняется в вызывающем потоке:
+// запуск потоков на маленьких группах дороже самой работы
+class Parallel {
+public:
+    static const size_t CacheLine = 64;
+
+    // Частичный результат потока занимает отдельную кэш-линию,
+    // чтобы соседние потоки не делили её при записи (false sharing)
+    template <typename T>
+    struct alignas(CacheLine) Padded {
+        T value;
+    };
+
+    static void setCutoff(size_t elementCount);
+    static size_t getCutoff();
+    // 0 - по числу аппаратных потоков
+    static void setThreadCount(size_t threads);
+    static size_t getThreadCount();
+
+    // Число кусков: 1 для последовательного пути
+    static size_t chunkCount(size_t count, Execution execution);
+
+    // body(chunk, begin, end) для каждого куска; нулевой кусок
+    // выполняется в вызывающем потоке
+    template <typename Body>
+    static void forChunks(size_t count, size_t chunks, Body body) {
+        if (chunks <= 1) {
+            body(size_t(0), size_t(0), count);
+            return;
+        }
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        for (size_t chunk = 1; chunk < chunks; ++chunk) {
+            workers.emplace_back([&body, chunk, chunks, count]() {
+                body(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+            });
+        }
+        body(size_t(0), size_t(0), count / chunks);
+        for (auto& worker : workers) worker.join();
+    }
+
+    // Свёртка по кускам: body(begin, end) -> T, затем combine по порядку кусков
+    template <typename T, typename Body, typename Combine>
+    static T reduce(size_t count, Execution execution, T init, Body body, Combine combine) {
+        size_t chunks = chunkCount(count, execution);
+        if (chunks <= 1) return combine(std::move(init), body(size_t(0), count));
+        std::vector<Padded<T>> partial(chunks);
+        forChunks(count, chunks, [&partial, &body](size_t chunk, size_t begin, size_t end) {
+            partial[chunk].value = body(begin, end);
+        });
+        for (auto& slot : partial) init = combine(std::move(init), std::move(slot.value));
+        return init;
+    }
+
+    // Куски сортируются параллельно, затем попарно сливаются
+    template <typename Iterator, typename Compare>
+    static void sort(Iterator first, Iterator last, Execution execution, Compare compare) {
+        size_t count = static_cast<size_t>(last - first);
+        size_t chunks = chunkCount(count, execution);
+        if (chunks <= 1) {
+            std::sort(first, last, compare);
+            return;
+        }
+        std::vector<size_t> bounds(chunks + 1);
+        for (size_t chunk = 0; chunk <= chunks; ++chunk) bounds[chunk] = count * chunk / chunks;
+        forChunks(count, chunks, [&](size_t, size_t begin, size_t end) {
+            std::sort(first + begin, first + end, compare);
+        });
+        for (size_t width = 1; width < chunks; width *= 2) {
+            size_t merges = (chunks + 2 * width - 1) / (2 * width);
+            forChunks(merges, merges, [&](size_t merge, size_t, size_t) {
+                size_t left = merge * 2 * width;
+                size_t middle = std::min(left + width, chunks);
+                size_t right = std::min(left + 2 * width, chunks);
+                if (middle < right) {
+                    std::inplace_merge(first + bounds[left], first + bounds[middle],
+                        first + bounds[right], compare);
+                }
+            });
+        }
+    }
+};
+
+#endif
\ No newline at end of file
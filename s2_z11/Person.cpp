@@ -1,15 +1,16 @@
 #include "Person.hpp"
 #include <iostream>
+#include <utility>
 
 Person::Person() : name("Unknown") {}
 
-Person::Person(const std::string& name) : name(name) {}
+Person::Person(std::string name) : name(std::move(name)) {}
 
 Person::~Person() {}
 
-std::string Person::getName() const { return name; }
+const std::string& Person::getName() const { return name; }
 
-void Person::setName(const std::string& newName) { name = newName; }
+void Person::setName(std::string newName) { name = std::move(newName); }
 
 void Person::print() const {
     std::cout << "Person: " << name;
@@ -8,13 +8,18 @@ class Person {
 protected:
     std::string name;
 
+    Person(const Person& other) = default;
+    Person(Person&& other) noexcept = default;
+    Person& operator=(const Person& other) = default;
+    Person& operator=(Person&& other) noexcept = default;
+
 public:
     Person();
-    explicit Person(const std::string& name);
+    explicit Person(std::string name);
     virtual ~Person();
 
-    std::string getName() const;
-    void setName(const std::string& newName);
+    const std::string& getName() const;
+    virtual void setName(std::string newName);
 
     virtual void print() const;
     virtual double getAverage() const = 0;
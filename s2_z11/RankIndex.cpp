@@ -0,0 +1,325 @@
+#include "RankIndex.hpp"
+#include "Student.hpp"
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+// Полный порядок по возрастанию: по среднему баллу, затем позже созданный
+// студент ниже. Номер создания совпадает только у перемещённого студента
+// и его пустого источника - их различает адрес
+bool RankIndex::less(double averageA, std::uint64_t sequenceA, const Student* a,
+    double averageB, std::uint64_t sequenceB, const Student* b) {
+    if (averageA != averageB) return averageA < averageB;
+    if (sequenceA != sequenceB) return sequenceA > sequenceB;
+    return std::less<const Student*>()(a, b);
+}
+
+bool RankIndex::less(const Node& a, const Node& b) {
+    return less(a.average, a.sequence, a.student, b.average, b.sequence, b.student);
+}
+
+bool RankIndex::less(std::int32_t node, double average, const Student* student) const {
+    return less(nodes[node].average, nodes[node].sequence, nodes[node].student,
+        average, student->getSequence(), student);
+}
+
+std::uint32_t RankIndex::nextPriority() {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+std::uint32_t RankIndex::sizeOf(std::int32_t node) const {
+    return node < 0 ? 0 : nodes[node].size;
+}
+
+void RankIndex::update(std::int32_t node) {
+    nodes[node].size = 1 + sizeOf(nodes[node].left) + sizeOf(nodes[node].right);
+}
+
+// left получает ключи строго меньше заданного, right - остальные
+void RankIndex::split(std::int32_t node, double average, const Student* student,
+    std::int32_t& left, std::int32_t& right) {
+    if (node < 0) {
+        left = right = -1;
+        return;
+    }
+    if (less(node, average, student)) {
+        split(nodes[node].right, average, student, nodes[node].right, right);
+        left = node;
+    }
+    else {
+        split(nodes[node].left, average, student, left, nodes[node].left);
+        right = node;
+    }
+    update(node);
+}
+
+std::int32_t RankIndex::merge(std::int32_t left, std::int32_t right) {
+    if (left < 0) return right;
+    if (right < 0) return left;
+    if (nodes[left].priority > nodes[right].priority) {
+        nodes[left].right = merge(nodes[left].right, right);
+        update(left);
+        return left;
+    }
+    nodes[right].left = merge(left, nodes[right].left);
+    update(right);
+    return right;
+}
+
+std::int32_t RankIndex::eraseFrom(std::int32_t node, double average, const Student* student,
+    bool& erased) {
+    if (node < 0) return -1;
+    Node& current = nodes[node];
+    if (current.average == average && current.student == student) {
+        std::int32_t replacement = merge(current.left, current.right);
+        freeNodes.push_back(node);
+        erased = true;
+        return replacement;
+    }
+    if (less(node, average, student)) {
+        std::int32_t right = eraseFrom(current.right, average, student, erased);
+        nodes[node].right = right;
+    }
+    else {
+        std::int32_t left = eraseFrom(current.left, average, student, erased);
+        nodes[node].left = left;
+    }
+    if (erased) update(node);
+    return node;
+}
+
+// Число ключей строго меньше заданного
+size_t RankIndex::countBelow(double average, const Student* student) const {
+    size_t count = 0;
+    std::int32_t node = root;
+    while (node >= 0) {
+        if (less(node, average, student)) {
+            count += sizeOf(nodes[node].left) + 1;
+            node = nodes[node].right;
+        }
+        else {
+            node = nodes[node].left;
+        }
+    }
+    return count;
+}
+
+// Декартово дерево по уже упорядоченным ключам строится за O(n) стеком
+// правой ветви: узел с большим приоритетом забирает снятую ветвь левым
+// поддеревом. Снятый со стека узел больше не меняется, и его размер
+// считается сразу
+void RankIndex::rebuild(std::vector<Node> sorted) {
+    nodes.swap(sorted);
+    freeNodes.clear();
+    freeNodes.reserve(nodes.capacity());
+    std::vector<std::int32_t> spine;
+    for (std::int32_t node = 0; node < static_cast<std::int32_t>(nodes.size()); ++node) {
+        std::int32_t last = -1;
+        while (!spine.empty() && nodes[spine.back()].priority < nodes[node].priority) {
+            last = spine.back();
+            spine.pop_back();
+            update(last);
+        }
+        nodes[node].left = last;
+        nodes[node].right = -1;
+        if (!spine.empty()) nodes[spine.back()].right = node;
+        spine.push_back(node);
+    }
+    root = spine.empty() ? -1 : spine.front();
+    while (!spine.empty()) {
+        update(spine.back());
+        spine.pop_back();
+    }
+}
+
+RankIndex::RankIndex() : root(-1), seed(2463534242u) {}
+
+void RankIndex::insert(double average, Student* student) {
+    std::int32_t node;
+    if (!freeNodes.empty()) {
+        node = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        node = static_cast<std::int32_t>(nodes.size());
+        nodes.emplace_back();
+        // Удаление кладёт узел в freeNodes и не должно выделять память
+        if (freeNodes.capacity() < nodes.capacity()) freeNodes.reserve(nodes.capacity());
+    }
+    nodes[node] = { average, student->getSequence(), student, nextPriority(), -1, -1, 1 };
+
+    std::int32_t left, right;
+    split(root, average, student, left, right);
+    root = merge(merge(left, node), right);
+}
+
+// Пакет не меньше дерева выгоднее отсортировать, слить с обходом дерева
+// и построить дерево заново, чем вставлять по одному за O(log n)
+void RankIndex::insertBatch(std::span<Student* const> batch) {
+    if (batch.size() < size()) {
+        for (auto* student : batch) insert(student->getAverage(), student);
+        return;
+    }
+    std::vector<Node> added;
+    added.reserve(batch.size());
+    for (auto* student : batch) {
+        added.push_back({ student->getAverage(), student->getSequence(), student, nextPriority(),
+            -1, -1, 1 });
+    }
+    std::sort(added.begin(), added.end(), [](const Node& a, const Node& b) { return less(a, b); });
+
+    std::vector<Node> present;
+    present.reserve(size());
+    std::vector<std::int32_t> stack;
+    std::int32_t node = root;
+    while (node >= 0 || !stack.empty()) {
+        while (node >= 0) {
+            stack.push_back(node);
+            node = nodes[node].left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        present.push_back(nodes[node]);
+        node = nodes[node].right;
+    }
+
+    std::vector<Node> sorted;
+    sorted.reserve(std::max(nodes.capacity(), present.size() + added.size()));
+    std::merge(present.begin(), present.end(), added.begin(), added.end(), std::back_inserter(sorted),
+        [](const Node& a, const Node& b) { return less(a, b); });
+    rebuild(std::move(sorted));
+}
+
+bool RankIndex::erase(double average, const Student* student) {
+    bool erased = false;
+    root = eraseFrom(root, average, student, erased);
+    return erased;
+}
+
+void RankIndex::clear() {
+    nodes.clear();
+    freeNodes.clear();
+    root = -1;
+}
+
+void RankIndex::reserve(size_t count) {
+    nodes.reserve(count);
+    freeNodes.reserve(nodes.capacity());
+}
+
+size_t RankIndex::size() const { return sizeOf(root); }
+
+Student* RankIndex::atRank(size_t rank) const {
+    if (rank >= size()) return nullptr;
+    // Ранг считается от наибольшего, в дереве ключи по возрастанию
+    size_t position = size() - 1 - rank;
+    std::int32_t node = root;
+    while (node >= 0) {
+        size_t leftSize = sizeOf(nodes[node].left);
+        if (position < leftSize) {
+            node = nodes[node].left;
+        }
+        else if (position == leftSize) {
+            return nodes[node].student;
+        }
+        else {
+            position -= leftSize + 1;
+            node = nodes[node].right;
+        }
+    }
+    return nullptr;
+}
+
+size_t RankIndex::rankOf(double average, const Student* student) const {
+    size_t below = countBelow(average, student);
+    if (below >= size()) return NotFound;
+    size_t rank = size() - 1 - below;
+    return atRank(rank) == student ? rank : NotFound;
+}
+
+// Обратный симметричный обход со стеком, останавливается после count узлов
+std::vector<Student*> RankIndex::top(size_t count) const {
+    std::vector<Student*> result;
+    result.reserve(count < size() ? count : size());
+    std::vector<std::int32_t> stack;
+    std::int32_t node = root;
+    while ((node >= 0 || !stack.empty()) && result.size() < count) {
+        while (node >= 0) {
+            stack.push_back(node);
+            node = nodes[node].right;
+        }
+        node = stack.back();
+        stack.pop_back();
+        result.push_back(nodes[node].student);
+        node = nodes[node].left;
+    }
+    return result;
+}
+
+std::vector<Student*> RankIndex::bottom(size_t count) const {
+    std::vector<Student*> result;
+    result.reserve(count < size() ? count : size());
+    std::vector<std::int32_t> stack;
+    std::int32_t node = root;
+    while ((node >= 0 || !stack.empty()) && result.size() < count) {
+        while (node >= 0) {
+            stack.push_back(node);
+            node = nodes[node].left;
+        }
+        node = stack.back();
+        stack.pop_back();
+        result.push_back(nodes[node].student);
+        node = nodes[node].right;
+    }
+    return result;
+}
+
+// Студенты со средним в [low, high], от большего к меньшему. Спуск сразу
+// к high отсекает всё, что выше диапазона
+std::vector<Student*> RankIndex::inRange(double low, double high) const {
+    std::vector<Student*> result;
+    std::vector<std::int32_t> stack;
+    std::int32_t node = root;
+    while (node >= 0 || !stack.empty()) {
+        while (node >= 0) {
+            if (nodes[node].average > high) {
+                node = nodes[node].left;
+                continue;
+            }
+            stack.push_back(node);
+            node = nodes[node].right;
+        }
+        node = stack.back();
+        stack.pop_back();
+        if (nodes[node].average < low) break;
+        result.push_back(nodes[node].student);
+        node = nodes[node].left;
+    }
+    return result;
+}
+
+std::vector<Student*> RankIndex::inOrder() const { return top(size()); }
+
+double RankIndex::getHighest() const {
+    if (root < 0) return 0.0;
+    std::int32_t node = root;
+    while (nodes[node].right >= 0) node = nodes[node].right;
+    return nodes[node].average;
+}
+
+double RankIndex::getLowest() const {
+    if (root < 0) return 0.0;
+    std::int32_t node = root;
+    while (nodes[node].left >= 0) node = nodes[node].left;
+    return nodes[node].average;
+}
+
+Student* RankIndex::getBest() const {
+    if (root < 0) return nullptr;
+    std::int32_t node = root;
+    while (nodes[node].right >= 0) node = nodes[node].right;
+    return nodes[node].student;
+}
\ No newline at end of file
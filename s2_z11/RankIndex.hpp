@@ -0,0 +1,77 @@
+#ifndef RANKINDEX_HPP
+#define RANKINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class Student;
+
+// Дерево порядковых статистик (декартово дерево с размерами поддеревьев)
+// по среднему баллу. Ранг 0 - наибольший средний балл, при равных средних
+// выше раньше созданный студент (Student::getSequence). Поиск ранга,
+// студента по рангу и вставка/удаление - O(log n), top-K и выборка по
+// диапазону - O(log n + k), пакетная вставка в небольшое дерево - одна
+// сортировка пакета и построение за O(n). Узлы хранятся в одном векторе без аллокаций
+// на каждую вставку
+class RankIndex {
+public:
+    static const size_t NotFound = static_cast<size_t>(-1);
+
+private:
+    struct Node {
+        double average;
+        std::uint64_t sequence;
+        Student* student;
+        std::uint32_t priority;
+        std::int32_t left;
+        std::int32_t right;
+        std::uint32_t size;
+    };
+
+    std::vector<Node> nodes;
+    std::vector<std::int32_t> freeNodes;
+    std::int32_t root;
+    std::uint32_t seed;
+
+    static bool less(double averageA, std::uint64_t sequenceA, const Student* a,
+        double averageB, std::uint64_t sequenceB, const Student* b);
+    static bool less(const Node& a, const Node& b);
+    bool less(std::int32_t node, double average, const Student* student) const;
+
+    std::uint32_t nextPriority();
+    std::uint32_t sizeOf(std::int32_t node) const;
+    void update(std::int32_t node);
+    void split(std::int32_t node, double average, const Student* student,
+        std::int32_t& left, std::int32_t& right);
+    std::int32_t merge(std::int32_t left, std::int32_t right);
+    std::int32_t eraseFrom(std::int32_t node, double average, const Student* student, bool& erased);
+    size_t countBelow(double average, const Student* student) const;
+    void rebuild(std::vector<Node> sorted);
+
+public:
+    RankIndex();
+
+    void insert(double average, Student* student);
+    void insertBatch(std::span<Student* const> batch);
+    bool erase(double average, const Student* student);
+    void clear();
+    void reserve(size_t count);
+
+    size_t size() const;
+    Student* atRank(size_t rank) const;
+    size_t rankOf(double average, const Student* student) const;
+    std::vector<Student*> top(size_t count) const;
+    std::vector<Student*> bottom(size_t count) const;
+    std::vector<Student*> inRange(double low, double high) const;
+    std::vector<Student*> inOrder() const;
+
+    double getHighest() const;
+    double getLowest() const;
+    Student* getBest() const;
+
+    inline bool empty() const { return root < 0; }
+};
+
+#endif
\ No newline at end of file
@@ -2,91 +2,269 @@
 #include <iostream>
 #include <algorithm>
 #include <iomanip>
+#include <cmath>
+#include <utility>
 
-void RecordBook::calculateAverage() {
-    if (grades.empty()) {
-        average = 0.0;
+// Welford: среднее и сумма квадратов отклонений обновляются за O(1).
+// count - число оценок вместе с добавленной. Конструктор, addGrade и
+// пакетная загрузка проходят один и тот же шаг, поэтому среднее не
+// зависит от того, каким путём оценки попали в зачётку
+void RecordBook::pushStatistics(double grade, size_t count) {
+    double delta = grade - average;
+    sum += grade;
+    average += delta / static_cast<double>(count);
+    m2 += delta * (grade - average);
+    lowest = count == 1 ? grade : std::min(lowest, grade);
+    highest = count == 1 ? grade : std::max(highest, grade);
+    histogram.add(grade);
+}
+
+// Минимум и максимум пересчитываются проходом по оценкам, только когда
+// снятая оценка была одним из них
+void RecordBook::rebuildExtremes() {
+    GradeView view = getGrades();
+    lowest = highest = view[0];
+    for (double grade : view) {
+        lowest = std::min(lowest, grade);
+        highest = std::max(highest, grade);
+    }
+}
+
+// Обратный шаг Welford. Вызывается после удаления последней оценки из grades.
+// Обратный шаг копит погрешность округления, поэтому статистика последней
+// оставшейся оценки берётся из неё самой
+void RecordBook::popStatistics(double grade) {
+    if (gradeCount() <= 1) {
+        resetStatistics();
+        if (gradeCount() == 1) {
+            double last = getGrades()[0];
+            if (isQuantized()) codeSum = codes()[0];
+            average = last;
+            sum = last;
+            lowest = highest = last;
+            histogram.add(last);
+        }
         return;
     }
-    double sum = 0.0;
-    for (double grade : grades) {
-        sum += grade;
+    double count = static_cast<double>(gradeCount());
+    double previousAverage = average;
+    sum -= grade;
+    average -= (grade - average) / count;
+    m2 -= (grade - average) * (grade - previousAverage);
+    if (m2 < 0.0) m2 = 0.0;
+    histogram.remove(grade);
+    if (grade <= lowest || grade >= highest) rebuildExtremes();
+}
+
+void RecordBook::resetStatistics() {
+    codeSum = 0;
+    average = 0.0;
+    sum = 0.0;
+    m2 = 0.0;
+    lowest = 0.0;
+    highest = 0.0;
+    histogram.clear();
+}
+
+size_t RecordBook::gradeCount() const {
+    return isQuantized() ? codes().size() : grades().size();
+}
+
+// В квантованном режиме оценка хранится как целое число шагов (1 байт),
+// а среднее считается точно через целочисленную сумму кодов
+void RecordBook::appendGrade(double grade) {
+    if (!isQuantized()) {
+        grades().push_back(grade);
+        pushStatistics(grade, grades().size());
+        return;
     }
-    average = sum / grades.size();
+    long code = std::lround(grade / gradeStep);
+    if (code * gradeStep > 5.0) --code;
+    codes().push_back(static_cast<std::uint8_t>(code));
+    pushStatistics(code * gradeStep, codes().size());
+    codeSum += static_cast<std::uint64_t>(code);
+    average = codeSum * gradeStep / codes().size();
 }
 
-RecordBook::RecordBook() : recordNumber("000000"), average(0.0) {}
+RecordBook::RecordBook()
+    : recordNumber("000000"), gradeStep(0.0), codeSum(0), average(0.0), sum(0.0), m2(0.0),
+    lowest(0.0), highest(0.0) {
+}
 
-RecordBook::RecordBook(const std::string& number)
-    : recordNumber(number), average(0.0) {
+RecordBook::RecordBook(std::string number)
+    : recordNumber(std::move(number)), gradeStep(0.0), codeSum(0), average(0.0), sum(0.0), m2(0.0),
+    lowest(0.0), highest(0.0) {
 }
 
-RecordBook::RecordBook(const std::string& number, const std::vector<double>& initialGrades)
-    : recordNumber(number), grades(initialGrades) {
-    calculateAverage();
+RecordBook::RecordBook(std::string number, const std::vector<double>& initialGrades)
+    : recordNumber(std::move(number)), gradeStep(0.0), codeSum(0), average(0.0), sum(0.0), m2(0.0),
+    lowest(0.0), highest(0.0) {
+    grades().reserve(initialGrades.size());
+    for (double grade : initialGrades) {
+        if (!isValidGrade(grade)) continue;
+        grades().push_back(grade);
+        pushStatistics(grade, grades().size());
+    }
+}
+
+RecordBook::RecordBook(std::string number, const std::vector<double>& initialGrades,
+    double step)
+    : RecordBook(std::move(number), initialGrades) {
+    setGradeStep(step);
 }
 
 RecordBook::RecordBook(const RecordBook& other)
-    : recordNumber(other.recordNumber), grades(other.grades), average(other.average) {
+    : recordNumber(other.recordNumber), storage(other.storage), gradeStep(other.gradeStep),
+    codeSum(other.codeSum), average(other.average), sum(other.sum), m2(other.m2),
+    lowest(other.lowest), highest(other.highest), histogram(other.histogram) {
+}
+
+// Буферы оценок забираются без копирования, исходная зачётка остаётся пустой
+RecordBook::RecordBook(RecordBook&& other) noexcept
+    : recordNumber(std::move(other.recordNumber)), storage(std::move(other.storage)),
+    gradeStep(other.gradeStep), codeSum(other.codeSum), average(other.average),
+    sum(other.sum), m2(other.m2), lowest(other.lowest), highest(other.highest),
+    histogram(other.histogram) {
+    other.resetStatistics();
+}
+
+RecordBook& RecordBook::operator=(RecordBook&& other) noexcept {
+    if (this != &other) {
+        recordNumber = std::move(other.recordNumber);
+        storage = std::move(other.storage);
+        gradeStep = other.gradeStep;
+        codeSum = other.codeSum;
+        average = other.average;
+        sum = other.sum;
+        m2 = other.m2;
+        lowest = other.lowest;
+        highest = other.highest;
+        histogram = other.histogram;
+        other.resetStatistics();
+    }
+    return *this;
 }
 
 RecordBook::~RecordBook() {}
 
 std::string RecordBook::getRecordNumber() const { return recordNumber; }
-double RecordBook::getAverage() const { return average; }
-const std::vector<double>& RecordBook::getGrades() const { return grades; }
-int RecordBook::getGradeCount() const { return static_cast<int>(grades.size()); }
+GradeView RecordBook::getGrades() const {
+    if (isQuantized()) return GradeView(codes().data(), codes().size(), gradeStep);
+    return GradeView(grades().data(), grades().size());
+}
+
+int RecordBook::getGradeCount() const { return static_cast<int>(gradeCount()); }
+double RecordBook::getGradeStep() const { return gradeStep; }
 
-void RecordBook::setRecordNumber(const std::string& number) { recordNumber = number; }
+void RecordBook::setRecordNumber(std::string number) { recordNumber = std::move(number); }
+
+// step == 0 возвращает точное хранение в double. Шаг должен укладывать
+// шкалу 0..5 в один байт. Уже выставленные оценки перекодируются
+bool RecordBook::setGradeStep(double step) {
+    if (!std::isfinite(step) || step < 0.0 || (step > 0.0 && 5.0 / step > 255.0)) return false;
+
+    std::vector<double> current = getGrades().toVector();
+    gradeStep = step;
+    resetStatistics();
+    if (isQuantized()) storage.emplace<CodedGrades>().reserve(current.size());
+    else storage.emplace<ExactGrades>().reserve(current.size());
+    for (double grade : current) {
+        appendGrade(grade);
+    }
+    return true;
+}
 
 bool RecordBook::addGrade(double grade) {
-    if (grade < 0 || grade > 5) return false;
-    grades.push_back(grade);
-    calculateAverage();
+    if (!isValidGrade(grade)) return false;
+    appendGrade(grade);
     return true;
 }
 
 bool RecordBook::addGrades(const std::vector<double>& newGrades) {
-    for (double grade : newGrades) {
-        if (grade >= 0 && grade <= 5) {
-            grades.push_back(grade);
+    ingestGrades(newGrades.data(), newGrades.size());
+    return true;
+}
+
+// Пакетная загрузка: ядро GradeKernels отбирает допустимые оценки прямо
+// в хвост буфера, статистика затем обновляется тем же шагом, что в addGrade.
+// Возвращает число отброшенных оценок
+size_t RecordBook::ingestGrades(const double* newGrades, size_t count) {
+    if (count == 0) return 0;
+
+    if (isQuantized()) {
+        std::vector<double> accepted(count + GradeKernels::KernelSlack);
+        IngestResult batch = GradeKernels::compactValid(newGrades, count, accepted.data());
+        codes().reserve(codes().size() + batch.accepted);
+        for (size_t i = 0; i < batch.accepted; ++i) {
+            appendGrade(accepted[i]);
         }
+        return batch.rejected;
     }
-    calculateAverage();
-    return true;
+
+    size_t previousCount = grades().size();
+    grades().reserve(previousCount + count + GradeKernels::KernelSlack);
+    IngestResult batch = GradeKernels::compactValid(newGrades, count,
+        grades().data() + previousCount);
+    grades().resize(previousCount + batch.accepted);
+    for (size_t i = previousCount; i < grades().size(); ++i) {
+        pushStatistics(grades()[i], i + 1);
+    }
+    return batch.rejected;
 }
 
 bool RecordBook::removeLastGrade() {
-    if (grades.empty()) return false;
-    grades.pop_back();
-    calculateAverage();
+    if (gradeCount() == 0) return false;
+    if (isQuantized()) {
+        std::uint8_t code = codes().back();
+        codes().pop_back();
+        std::uint64_t remaining = codeSum - code;
+        popStatistics(code * gradeStep);
+        if (!codes().empty()) {
+            codeSum = remaining;
+            average = codeSum * gradeStep / codes().size();
+        }
+        return true;
+    }
+    double grade = grades().back();
+    grades().pop_back();
+    popStatistics(grade);
     return true;
 }
 
 void RecordBook::clearGrades() {
-    grades.clear();
-    average = 0.0;
+    if (isQuantized()) codes().clear();
+    else grades().clear();
+    resetStatistics();
 }
 
-double RecordBook::getHighestGrade() const {
-    if (grades.empty()) return 0.0;
-    return *std::max_element(grades.begin(), grades.end());
+double RecordBook::getHighestGrade() const { return highest; }
+double RecordBook::getLowestGrade() const { return lowest; }
+
+double RecordBook::getSum() const {
+    return isQuantized() ? codeSum * gradeStep : sum;
 }
 
-double RecordBook::getLowestGrade() const {
-    if (grades.empty()) return 0.0;
-    return *std::min_element(grades.begin(), grades.end());
+double RecordBook::getVariance() const {
+    if (gradeCount() == 0) return 0.0;
+    return m2 / gradeCount();
 }
 
-bool RecordBook::hasGrades() const { return !grades.empty(); }
+double RecordBook::getStandardDeviation() const { return std::sqrt(getVariance()); }
+
+double RecordBook::getMedian() const { return histogram.getMedian(); }
+double RecordBook::getPercentile(double percent) const { return histogram.getPercentile(percent); }
+double RecordBook::getMode() const { return histogram.getMode(); }
+const GradeHistogram& RecordBook::getHistogram() const { return histogram; }
+
+bool RecordBook::hasGrades() const { return gradeCount() != 0; }
 
 void RecordBook::print() const {
     std::cout << "Record Book #" << recordNumber << "\n  Grades: ";
-    if (grades.empty()) {
+    if (!hasGrades()) {
         std::cout << "none";
     }
     else {
-        for (double g : grades) {
+        for (double g : getGrades()) {
             std::cout << g << " ";
         }
     }
@@ -3,41 +3,93 @@
 
 #include <string>
 #include <vector>
+#include <variant>
+#include <cstdint>
+#include "GradeView.hpp"
+#include "GradeBuffer.hpp"
+#include "GradeKernels.hpp"
+#include "GradeHistogram.hpp"
 
 class RecordBook {
 private:
+    using ExactGrades = GradeBuffer<double, 8>;
+    using CodedGrades = GradeBuffer<std::uint8_t, 64>;
+
     std::string recordNumber;
-    std::vector<double> grades;
+    // В квантованном режиме оценки хранятся кодами шагов, иначе - в double
+    std::variant<ExactGrades, CodedGrades> storage;
+    double gradeStep;
+    std::uint64_t codeSum;
     double average;
+    double sum;
+    double m2;
+    double lowest;
+    double highest;
+    GradeHistogram histogram;
+
+    inline ExactGrades& grades() { return *std::get_if<ExactGrades>(&storage); }
+    inline const ExactGrades& grades() const { return *std::get_if<ExactGrades>(&storage); }
+    inline CodedGrades& codes() { return *std::get_if<CodedGrades>(&storage); }
+    inline const CodedGrades& codes() const { return *std::get_if<CodedGrades>(&storage); }
 
-    void calculateAverage();
+    void pushStatistics(double grade, size_t count);
+    void popStatistics(double grade);
+    void rebuildExtremes();
+    void resetStatistics();
+    size_t gradeCount() const;
+    void appendGrade(double grade);
 
 public:
     RecordBook();
-    explicit RecordBook(const std::string& number);
-    RecordBook(const std::string& number, const std::vector<double>& initialGrades);
+    explicit RecordBook(std::string number);
+    RecordBook(std::string number, const std::vector<double>& initialGrades);
+    RecordBook(std::string number, const std::vector<double>& initialGrades,
+        double step);
     RecordBook(const RecordBook& other);
+    RecordBook(RecordBook&& other) noexcept;
+    RecordBook& operator=(const RecordBook& other) = default;
+    RecordBook& operator=(RecordBook&& other) noexcept;
     ~RecordBook();
 
     std::string getRecordNumber() const;
-    double getAverage() const;
-    const std::vector<double>& getGrades() const;
+    GradeView getGrades() const;
     int getGradeCount() const;
+    double getGradeStep() const;
 
-    void setRecordNumber(const std::string& number);
+    void setRecordNumber(std::string number);
+    bool setGradeStep(double step);
 
     bool addGrade(double grade);
     bool addGrades(const std::vector<double>& newGrades);
+    size_t ingestGrades(const double* newGrades, size_t count);
     bool removeLastGrade();
     void clearGrades();
 
     double getHighestGrade() const;
     double getLowestGrade() const;
+    double getSum() const;
+    double getVariance() const;
+    double getStandardDeviation() const;
+    double getMedian() const;
+    double getPercentile(double percent) const;
+    double getMode() const;
+    const GradeHistogram& getHistogram() const;
     bool hasGrades() const;
 
     void print() const;
 
+    // NaN не проходит ни одно сравнение, бесконечности - диапазон,
+    // поэтому в зачётку попадают только конечные оценки из [0, 5]
+    static inline bool isValidGrade(double grade) { return grade >= 0.0 && grade <= 5.0; }
+
+    inline double getAverage() const { return average; }
     inline bool isValidRecord() const { return !recordNumber.empty(); }
+    inline bool isQuantized() const { return gradeStep > 0.0; }
 };
 
+// Зачётка хранит одно представление оценок, минимум с максимумом и
+// гистограмму; запас на случай, если новое поле незаметно раздует студента
+static_assert(sizeof(RecordBook) <= sizeof(std::string) + 352,
+    "RecordBook should stay compact");
+
 #endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+#include "SelfTest.hpp"
+#include "RecordBook.hpp"
+#include "Group.hpp"
+#include <string>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+bool SelfTest::check(bool condition, const char* name) {
+    if (condition) std::cout << "  " << name << ": ok\n";
+    else std::cerr << "  " << name << ": FAILED\n";
+    return condition;
+}
+
+bool SelfTest::runAll() {
+    bool passed = true;
+    passed &= testIngestionPaths();
+    passed &= testStudentRelocation();
+    passed &= testTakeBeforeOrderBy();
+    passed &= testSortTieBreak();
+    return passed;
+}
+
+// Конструктор, addGrade и пакетная addGrades должны давать побитово
+// одинаковые среднее и дисперсию, в том числе при дозагрузке пакета
+bool SelfTest::testIngestionPaths() {
+    std::vector<double> grades;
+    for (int i = 0; i < 1000; ++i) {
+        grades.push_back(3.0 + (i % 17) * 0.1 + i * 1e-7);
+    }
+
+    RecordBook constructed("1", grades);
+    RecordBook single("2");
+    for (double grade : grades) {
+        single.addGrade(grade);
+    }
+    RecordBook batched("3");
+    batched.addGrades(std::vector<double>(grades.begin(), grades.begin() + 300));
+    batched.addGrades(std::vector<double>(grades.begin() + 300, grades.end()));
+
+    auto sameBits = [](double a, double b) { return std::memcmp(&a, &b, sizeof(double)) == 0; };
+    bool identical = sameBits(constructed.getAverage(), single.getAverage()) &&
+        sameBits(single.getAverage(), batched.getAverage()) &&
+        sameBits(constructed.getVariance(), single.getVariance()) &&
+        sameBits(single.getVariance(), batched.getVariance());
+    return check(identical, "identical statistics for constructor, addGrade and addGrades");
+}
+
+// Перестройка вектора перемещает студентов: группа должна следовать за ними
+bool SelfTest::testStudentRelocation() {
+    Group group("Relocation");
+    std::vector<Student> students;
+    students.reserve(1);
+    for (int i = 0; i < 20; ++i) {
+        students.emplace_back("S" + std::to_string(i), "0", std::vector<double>{ (i % 5) + 0.5 });
+        group.addStudent(students.back());
+    }
+
+    bool followed = group.getStudentCount() == students.size();
+    for (size_t i = 0; followed && i < students.size(); ++i) {
+        followed = group.getStudents()[i] == &students[i] &&
+            group.findStudent(students[i].getName()) == &students[i] &&
+            group.rankOf(&students[i]) != RankIndex::NotFound;
+    }
+    return check(followed, "group follows students moved by vector growth");
+}
+
+// take(n) до orderBy упорядочивает первые n подходящих, после - выбирает n лучших
+bool SelfTest::testTakeBeforeOrderBy() {
+    Group group("Ordering");
+    std::vector<Student> students;
+    students.reserve(4);
+    const double averages[] = { 3.0, 4.0, 5.0, 2.0 };
+    for (int i = 0; i < 4; ++i) {
+        students.emplace_back("S" + std::to_string(i), "0", std::vector<double>{ averages[i] });
+        group.addStudent(students.back());
+    }
+    auto byAverage = [](const Student& student) { return student.getAverage(); };
+
+    std::vector<std::string> firstTwo;
+    for (const Student& student : group.all().take(2).orderByDescending(byAverage)) {
+        firstTwo.push_back(student.getName());
+    }
+    std::vector<std::string> bestTwo;
+    for (const Student& student : group.all().orderByDescending(byAverage).take(2)) {
+        bestTwo.push_back(student.getName());
+    }
+    bool ordered = firstTwo == std::vector<std::string>{ "S1", "S0" } &&
+        bestTwo == std::vector<std::string>{ "S2", "S1" };
+    return check(ordered, "take before orderBy limits the ordered input");
+}
+
+// Равные средние сортируются по порядку создания студентов, а не по
+// порядку в группе или адресу, одинаково с таблицей и без неё
+bool SelfTest::testSortTieBreak() {
+    std::vector<Student> students;
+    students.reserve(4);
+    const double averages[] = { 4.0, 4.0, 4.0, 5.0 };
+    for (int i = 0; i < 4; ++i) {
+        students.emplace_back("S" + std::to_string(i), "0", std::vector<double>{ averages[i] });
+    }
+    const size_t joinOrder[] = { 2, 0, 3, 1 };
+
+    bool sorted = true;
+    for (bool columns : { false, true }) {
+        Group group(columns ? "Columns" : "Rows");
+        group.setColumnsEnabled(columns);
+        for (size_t index : joinOrder) group.addStudent(students[index]);
+        group.sortStudentsByAverage();
+        std::vector<std::string> names;
+        for (const auto* student : group.getStudents()) names.push_back(student->getName());
+        sorted = sorted && names == std::vector<std::string>{ "S3", "S0", "S1", "S2" } &&
+            group.findStudent("S1") == &students[1] && group.studentAtRank(1) == &students[0];
+    }
+    return check(sorted, "equal averages sort by creation order");
+}
\ No newline at end of file
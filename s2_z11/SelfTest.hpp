@@ -0,0 +1,19 @@
+#ifndef SELFTEST_HPP
+#define SELFTEST_HPP
+
+// Проверки инвариантов, которые легко сломать незаметно: каждая печатает
+// своё имя и результат, runAll возвращает false, если хоть одна не прошла
+class SelfTest {
+private:
+    static bool check(bool condition, const char* name);
+
+public:
+    static bool runAll();
+
+    static bool testIngestionPaths();
+    static bool testStudentRelocation();
+    static bool testTakeBeforeOrderBy();
+    static bool testSortTieBreak();
+};
+
+#endif
\ No newline at end of file
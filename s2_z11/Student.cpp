@@ -1,43 +1,191 @@
 #include "Student.hpp"
 #include <iostream>
 #include <iomanip>
+#include <algorithm>
+#include <atomic>
+#include <utility>
 
-Student::Student() : Person(), recordBook() {}
+std::uint64_t Student::nextSequence() {
+    static std::atomic<std::uint64_t> counter(0);
+    return counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Student::notifyChanging() {
+    for (size_t i = 0; i < listeners.size(); ++i) {
+        listeners[i]->onGradesChanging(*this);
+    }
+}
+
+void Student::notifyChanged() {
+    for (size_t i = 0; i < listeners.size(); ++i) {
+        listeners[i]->onGradesChanged(*this);
+    }
+}
 
-Student::Student(const std::string& name) : Person(name), recordBook() {}
+Student::Student() : Person(), recordBook(), sequence(nextSequence()) {}
 
-Student::Student(const std::string& name, const std::string& recordNumber)
-    : Person(name), recordBook(recordNumber) {
+void Student::notifyRenamed(const std::string& oldName) {
+    for (size_t i = 0; i < listeners.size(); ++i) {
+        listeners[i]->onStudentRenamed(*this, oldName);
+    }
 }
 
-Student::Student(const std::string& name, const std::string& recordNumber,
+Student::Student(std::string name)
+    : Person(std::move(name)), recordBook(), sequence(nextSequence()) {
+}
+
+Student::Student(std::string name, std::string recordNumber)
+    : Person(std::move(name)), recordBook(std::move(recordNumber)), sequence(nextSequence()) {
+}
+
+Student::Student(std::string name, std::string recordNumber,
     const std::vector<double>& grades)
-    : Person(name), recordBook(recordNumber, grades) {
+    : Person(std::move(name)), recordBook(std::move(recordNumber), grades),
+    sequence(nextSequence()) {
 }
 
-Student::Student(const Student& other) : Person(other), recordBook(other.recordBook) {}
+// Подписки не копируются: копия ещё не состоит ни в одной группе.
+// Копия - новый студент, номер создания у неё свой
+Student::Student(const Student& other)
+    : Person(other), recordBook(other.recordBook), sequence(nextSequence()) {
+}
 
-Student::~Student() {}
+Student& Student::operator=(const Student& other) {
+    if (this != &other) {
+        notifyChanging();
+        std::string oldName = std::move(name);
+        Person::operator=(other);
+        recordBook = other.recordBook;
+        notifyChanged();
+        notifyRenamed(oldName);
+    }
+    return *this;
+}
+
+// Перемещение забирает имя, буферы оценок и подписки без копирования.
+// Данные не меняются, поэтому группы только переставляют указатель
+Student::Student(Student&& other) noexcept
+    : Person(std::move(other)), recordBook(std::move(other.recordBook)),
+    listeners(std::move(other.listeners)), sequence(other.sequence) {
+    other.listeners.clear();
+    for (auto* listener : listeners) {
+        listener->onStudentMoved(other, *this);
+    }
+}
+
+// Прежний студент по этому адресу перестаёт существовать для своих групп,
+// его место в группах источника занимает этот объект
+Student& Student::operator=(Student&& other) noexcept {
+    if (this != &other) {
+        std::vector<GradeListener*> previous;
+        previous.swap(listeners);
+        for (auto* listener : previous) {
+            listener->onStudentDestroyed(*this);
+        }
+        Person::operator=(std::move(other));
+        recordBook = std::move(other.recordBook);
+        sequence = other.sequence;
+        listeners = std::move(other.listeners);
+        other.listeners.clear();
+        for (auto* listener : listeners) {
+            listener->onStudentMoved(other, *this);
+        }
+    }
+    return *this;
+}
+
+Student::~Student() {
+    std::vector<GradeListener*> current;
+    current.swap(listeners);
+    for (auto* listener : current) {
+        listener->onStudentDestroyed(*this);
+    }
+}
 
 std::string Student::getRecordNumber() const { return recordBook.getRecordNumber(); }
-double Student::getAverage() const { return recordBook.getAverage(); }
-const std::vector<double>& Student::getGrades() const { return recordBook.getGrades(); }
+GradeView Student::getGrades() const { return recordBook.getGrades(); }
+double Student::getGradeStep() const { return recordBook.getGradeStep(); }
+
+void Student::setName(std::string newName) {
+    std::string oldName = std::move(name);
+    Person::setName(std::move(newName));
+    notifyRenamed(oldName);
+}
 
-void Student::setRecordNumber(const std::string& number) {
-    recordBook.setRecordNumber(number);
+void Student::setRecordNumber(std::string number) {
+    recordBook.setRecordNumber(std::move(number));
+}
+
+bool Student::setGradeStep(double step) {
+    notifyChanging();
+    bool result = recordBook.setGradeStep(step);
+    notifyChanged();
+    return result;
+}
+
+bool Student::addGrade(double grade) {
+    if (!RecordBook::isValidGrade(grade)) return false;
+    notifyChanging();
+    bool result = recordBook.addGrade(grade);
+    notifyChanged();
+    return result;
 }
 
-bool Student::addGrade(double grade) { return recordBook.addGrade(grade); }
 bool Student::addGrades(const std::vector<double>& grades) {
-    return recordBook.addGrades(grades);
+    notifyChanging();
+    bool result = recordBook.addGrades(grades);
+    notifyChanged();
+    return result;
+}
+
+size_t Student::ingestGrades(const std::vector<double>& grades) {
+    return ingestGrades(grades.data(), grades.size());
+}
+
+size_t Student::ingestGrades(const double* grades, size_t count) {
+    notifyChanging();
+    size_t rejected = recordBook.ingestGrades(grades, count);
+    notifyChanged();
+    return rejected;
+}
+
+bool Student::removeLastGrade() {
+    if (!recordBook.hasGrades()) return false;
+    notifyChanging();
+    recordBook.removeLastGrade();
+    notifyChanged();
+    return true;
+}
+
+void Student::clearGrades() {
+    notifyChanging();
+    recordBook.clearGrades();
+    notifyChanged();
 }
-bool Student::removeLastGrade() { return recordBook.removeLastGrade(); }
-void Student::clearGrades() { recordBook.clearGrades(); }
 
 double Student::getHighestGrade() const { return recordBook.getHighestGrade(); }
 double Student::getLowestGrade() const { return recordBook.getLowestGrade(); }
+double Student::getStandardDeviation() const { return recordBook.getStandardDeviation(); }
+double Student::getMedian() const { return recordBook.getMedian(); }
+double Student::getPercentile(double percent) const { return recordBook.getPercentile(percent); }
+double Student::getMode() const { return recordBook.getMode(); }
+const GradeHistogram& Student::getHistogram() const { return recordBook.getHistogram(); }
 bool Student::hasGrades() const { return recordBook.hasGrades(); }
 
+void Student::subscribe(GradeListener* listener) {
+    if (listener) listeners.push_back(listener);
+}
+
+void Student::unsubscribe(GradeListener* listener) {
+    auto it = std::find(listeners.begin(), listeners.end(), listener);
+    if (it != listeners.end()) listeners.erase(it);
+}
+
+void Student::replaceListener(GradeListener* oldListener, GradeListener* newListener) {
+    auto it = std::find(listeners.begin(), listeners.end(), oldListener);
+    if (it != listeners.end()) *it = newListener;
+}
+
 void Student::print() const {
     std::cout << "Student: " << name << " (Record: " << recordBook.getRecordNumber()
         << ", Avg: " << std::fixed << std::setprecision(2) << getAverage() << ")";
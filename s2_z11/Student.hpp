@@ -3,40 +3,78 @@
 
 #include "Person.hpp"
 #include "RecordBook.hpp"
+#include "GradeListener.hpp"
 #include <vector>
+#include <cstdint>
 
-class Student : public Person {
+// final: вызов getAverage через Student* не идёт через vtable и
+// встраивается до чтения поля RecordBook
+class Student final : public Person {
 private:
     RecordBook recordBook;
+    std::vector<GradeListener*> listeners;
+    // Номер слота в StudentStore; копии и перемещённые объекты слота не имеют
+    std::uint32_t storeSlot = NoStoreSlot;
+    // Порядковый номер создания, переезжает при перемещении. При равных
+    // средних раньше созданный студент стоит в рейтинге выше
+    std::uint64_t sequence;
+
+    static std::uint64_t nextSequence();
+
+    void notifyChanging();
+    void notifyChanged();
+    void notifyRenamed(const std::string& oldName);
 
 public:
+    static const std::uint32_t NoStoreSlot = static_cast<std::uint32_t>(-1);
+
     Student();
-    explicit Student(const std::string& name);
-    Student(const std::string& name, const std::string& recordNumber);
-    Student(const std::string& name, const std::string& recordNumber,
-        const std::vector<double>& grades);
+    explicit Student(std::string name);
+    Student(std::string name, std::string recordNumber);
+    Student(std::string name, std::string recordNumber, const std::vector<double>& grades);
     Student(const Student& other);
+    Student(Student&& other) noexcept;
+    Student& operator=(const Student& other);
+    Student& operator=(Student&& other) noexcept;
     ~Student() override;
 
     std::string getRecordNumber() const;
-    double getAverage() const override;
-    const std::vector<double>& getGrades() const;
+    GradeView getGrades() const;
+    double getGradeStep() const;
 
-    void setRecordNumber(const std::string& number);
+    void setName(std::string newName) override;
+    void setRecordNumber(std::string number);
+    bool setGradeStep(double step);
 
     bool addGrade(double grade);
     bool addGrades(const std::vector<double>& grades);
+    size_t ingestGrades(const std::vector<double>& grades);
+    size_t ingestGrades(const double* grades, size_t count);
     bool removeLastGrade();
     void clearGrades();
 
     double getHighestGrade() const;
     double getLowestGrade() const;
+    double getStandardDeviation() const;
+    double getMedian() const;
+    double getPercentile(double percent) const;
+    double getMode() const;
+    const GradeHistogram& getHistogram() const;
     bool hasGrades() const;
 
+    void subscribe(GradeListener* listener);
+    void unsubscribe(GradeListener* listener);
+    void replaceListener(GradeListener* oldListener, GradeListener* newListener);
+
     void print() const override;
     std::string getType() const override;
 
+    inline double getAverage() const override { return recordBook.getAverage(); }
     inline bool hasRecordBook() const { return !recordBook.getRecordNumber().empty(); }
+    inline std::uint32_t getStoreSlot() const { return storeSlot; }
+    inline std::uint64_t getSequence() const { return sequence; }
+    // Вызывается только из StudentStore
+    inline void setStoreSlot(std::uint32_t slot) { storeSlot = slot; }
 };
 
 #endif
\ No newline at end of file
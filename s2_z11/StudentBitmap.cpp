@@ -0,0 +1,212 @@
+#include "StudentBitmap.hpp"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+
+// Позиция блока с ключом key или место для его вставки
+size_t StudentBitmap::findContainer(std::uint16_t key) const {
+    auto it = std::lower_bound(containers.begin(), containers.end(), key,
+        [](const Container& container, std::uint16_t value) { return container.key < value; });
+    return static_cast<size_t>(it - containers.begin());
+}
+
+void StudentBitmap::toWords(const Container& container, std::vector<std::uint64_t>& words) {
+    if (container.isBitmap()) {
+        words = container.words;
+        return;
+    }
+    words.assign(BitmapWords, 0);
+    for (std::uint16_t value : container.values) {
+        words[value >> 6] |= std::uint64_t(1) << (value & 63);
+    }
+}
+
+// Плотный блок - битовая карта, разреженный - массив
+void StudentBitmap::normalize(Container& container) {
+    if (container.isBitmap() && container.cardinality <= ArrayLimit) {
+        container.values.clear();
+        container.values.reserve(container.cardinality);
+        for (size_t word = 0; word < BitmapWords; ++word) {
+            std::uint64_t bits = container.words[word];
+            while (bits) {
+                int bit = std::countr_zero(bits);
+                container.values.push_back(static_cast<std::uint16_t>(word * 64 + bit));
+                bits &= bits - 1;
+            }
+        }
+        container.words.clear();
+        container.words.shrink_to_fit();
+    }
+    else if (!container.isBitmap() && container.cardinality > ArrayLimit) {
+        toWords(container, container.words);
+        container.values.clear();
+        container.values.shrink_to_fit();
+    }
+}
+
+StudentBitmap::Container StudentBitmap::combine(const Container& a, const Container& b,
+    Operation operation) {
+    Container result{ a.key, 0, {}, {} };
+    if (!a.isBitmap() && !b.isBitmap()) {
+        auto out = std::back_inserter(result.values);
+        if (operation == Operation::And) {
+            std::set_intersection(a.values.begin(), a.values.end(),
+                b.values.begin(), b.values.end(), out);
+        }
+        else if (operation == Operation::Or) {
+            std::set_union(a.values.begin(), a.values.end(),
+                b.values.begin(), b.values.end(), out);
+        }
+        else {
+            std::set_difference(a.values.begin(), a.values.end(),
+                b.values.begin(), b.values.end(), out);
+        }
+        result.cardinality = static_cast<std::uint32_t>(result.values.size());
+    }
+    else {
+        std::vector<std::uint64_t> left, right;
+        toWords(a, left);
+        toWords(b, right);
+        result.words.resize(BitmapWords);
+        std::uint32_t count = 0;
+        for (size_t i = 0; i < BitmapWords; ++i) {
+            std::uint64_t word = operation == Operation::And ? left[i] & right[i]
+                : operation == Operation::Or ? left[i] | right[i]
+                : left[i] & ~right[i];
+            result.words[i] = word;
+            count += static_cast<std::uint32_t>(std::popcount(word));
+        }
+        result.cardinality = count;
+    }
+    normalize(result);
+    return result;
+}
+
+// Слияние списков блоков по ключу; пустые блоки не сохраняются
+StudentBitmap StudentBitmap::combine(const StudentBitmap& a, const StudentBitmap& b,
+    Operation operation) {
+    StudentBitmap result;
+    size_t i = 0, j = 0;
+    while (i < a.containers.size() || j < b.containers.size()) {
+        bool hasA = i < a.containers.size();
+        bool hasB = j < b.containers.size();
+        if (hasA && (!hasB || a.containers[i].key < b.containers[j].key)) {
+            if (operation != Operation::And) result.containers.push_back(a.containers[i]);
+            ++i;
+        }
+        else if (hasB && (!hasA || b.containers[j].key < a.containers[i].key)) {
+            if (operation == Operation::Or) result.containers.push_back(b.containers[j]);
+            ++j;
+        }
+        else {
+            Container merged = combine(a.containers[i], b.containers[j], operation);
+            if (merged.cardinality) result.containers.push_back(std::move(merged));
+            ++i;
+            ++j;
+        }
+    }
+    return result;
+}
+
+void StudentBitmap::add(std::uint32_t id) {
+    std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+    std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    size_t index = findContainer(key);
+    if (index == containers.size() || containers[index].key != key) {
+        containers.insert(containers.begin() + index, Container{ key, 0, {}, {} });
+    }
+    Container& container = containers[index];
+    if (container.isBitmap()) {
+        std::uint64_t mask = std::uint64_t(1) << (low & 63);
+        if (container.words[low >> 6] & mask) return;
+        container.words[low >> 6] |= mask;
+    }
+    else {
+        auto it = std::lower_bound(container.values.begin(), container.values.end(), low);
+        if (it != container.values.end() && *it == low) return;
+        container.values.insert(it, low);
+    }
+    ++container.cardinality;
+    normalize(container);
+}
+
+bool StudentBitmap::remove(std::uint32_t id) {
+    std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+    std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    size_t index = findContainer(key);
+    if (index == containers.size() || containers[index].key != key) return false;
+    Container& container = containers[index];
+    if (container.isBitmap()) {
+        std::uint64_t mask = std::uint64_t(1) << (low & 63);
+        if (!(container.words[low >> 6] & mask)) return false;
+        container.words[low >> 6] &= ~mask;
+    }
+    else {
+        auto it = std::lower_bound(container.values.begin(), container.values.end(), low);
+        if (it == container.values.end() || *it != low) return false;
+        container.values.erase(it);
+    }
+    if (--container.cardinality == 0) containers.erase(containers.begin() + index);
+    else normalize(container);
+    return true;
+}
+
+bool StudentBitmap::contains(std::uint32_t id) const {
+    std::uint16_t key = static_cast<std::uint16_t>(id >> 16);
+    std::uint16_t low = static_cast<std::uint16_t>(id & 0xFFFF);
+    size_t index = findContainer(key);
+    if (index == containers.size() || containers[index].key != key) return false;
+    const Container& container = containers[index];
+    if (container.isBitmap()) return (container.words[low >> 6] >> (low & 63)) & 1;
+    return std::binary_search(container.values.begin(), container.values.end(), low);
+}
+
+void StudentBitmap::clear() { containers.clear(); }
+
+size_t StudentBitmap::cardinality() const {
+    size_t total = 0;
+    for (const auto& container : containers) total += container.cardinality;
+    return total;
+}
+
+std::vector<std::uint32_t> StudentBitmap::toVector() const {
+    std::vector<std::uint32_t> result;
+    result.reserve(cardinality());
+    for (const auto& container : containers) {
+        std::uint32_t high = static_cast<std::uint32_t>(container.key) << 16;
+        if (!container.isBitmap()) {
+            for (std::uint16_t value : container.values) result.push_back(high | value);
+            continue;
+        }
+        for (size_t word = 0; word < BitmapWords; ++word) {
+            std::uint64_t bits = container.words[word];
+            while (bits) {
+                result.push_back(high | static_cast<std::uint32_t>(word * 64 + std::countr_zero(bits)));
+                bits &= bits - 1;
+            }
+        }
+    }
+    return result;
+}
+
+StudentBitmap StudentBitmap::operator&(const StudentBitmap& other) const {
+    return combine(*this, other, Operation::And);
+}
+
+StudentBitmap StudentBitmap::operator|(const StudentBitmap& other) const {
+    return combine(*this, other, Operation::Or);
+}
+
+StudentBitmap StudentBitmap::andNot(const StudentBitmap& other) const {
+    return combine(*this, other, Operation::AndNot);
+}
+
+StudentBitmap& StudentBitmap::operator&=(const StudentBitmap& other) {
+    *this = combine(*this, other, Operation::And);
+    return *this;
+}
+
+StudentBitmap& StudentBitmap::operator|=(const StudentBitmap& other) {
+    *this = combine(*this, other, Operation::Or);
+    return *this;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef STUDENTBITMAP_HPP
+#define STUDENTBITMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Сжатое множество id студентов в духе roaring bitmap: id делятся на блоки
+// по 65536 (старшие 16 бит), каждый блок хранится либо отсортированным
+// массивом младших 16 бит (до 4096 элементов), либо битовой картой на
+// 1024 слова. Пересечение, объединение и разность идут по словам
+class StudentBitmap {
+private:
+    static const size_t ArrayLimit = 4096;
+    static const size_t BitmapWords = 1024;
+
+    struct Container {
+        std::uint16_t key;
+        std::uint32_t cardinality;
+        std::vector<std::uint16_t> values;
+        std::vector<std::uint64_t> words;
+
+        inline bool isBitmap() const { return !words.empty(); }
+    };
+
+    enum class Operation { And, Or, AndNot };
+
+    std::vector<Container> containers;
+
+    size_t findContainer(std::uint16_t key) const;
+    static void toWords(const Container& container, std::vector<std::uint64_t>& words);
+    static void normalize(Container& container);
+    static Container combine(const Container& a, const Container& b, Operation operation);
+    static StudentBitmap combine(const StudentBitmap& a, const StudentBitmap& b,
+        Operation operation);
+
+public:
+    void add(std::uint32_t id);
+    bool remove(std::uint32_t id);
+    bool contains(std::uint32_t id) const;
+    void clear();
+
+    size_t cardinality() const;
+    std::vector<std::uint32_t> toVector() const;
+
+    StudentBitmap operator&(const StudentBitmap& other) const;
+    StudentBitmap operator|(const StudentBitmap& other) const;
+    StudentBitmap andNot(const StudentBitmap& other) const;
+    StudentBitmap& operator&=(const StudentBitmap& other);
+    StudentBitmap& operator|=(const StudentBitmap& other);
+
+    inline bool empty() const { return containers.empty(); }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+#include "StudentColumns.hpp"
+#include "Student.hpp"
+
+StudentColumns::StudentColumns() : nextId(0) {}
+
+void StudentColumns::push(const Student& student) {
+    averages.push_back(student.getAverage());
+    gradeCounts.push_back(static_cast<std::uint32_t>(student.getGrades().size()));
+    ids.push_back(nextId++);
+}
+
+void StudentColumns::update(size_t slot, const Student& student) {
+    averages[slot] = student.getAverage();
+    gradeCounts[slot] = static_cast<std::uint32_t>(student.getGrades().size());
+}
+
+void StudentColumns::erase(size_t slot) {
+    averages.erase(averages.begin() + slot);
+    gradeCounts.erase(gradeCounts.begin() + slot);
+    ids.erase(ids.begin() + slot);
+}
+
+void StudentColumns::swapErase(size_t slot) {
+    size_t last = averages.size() - 1;
+    if (slot != last) move(last, slot);
+    truncate(last);
+}
+
+void StudentColumns::move(size_t from, size_t to) {
+    averages[to] = averages[from];
+    gradeCounts[to] = gradeCounts[from];
+    ids[to] = ids[from];
+}
+
+void StudentColumns::truncate(size_t count) {
+    averages.resize(count);
+    gradeCounts.resize(count);
+    ids.resize(count);
+}
+
+// order[i] - старая позиция элемента, который встаёт на место i
+void StudentColumns::permute(const std::vector<size_t>& order) {
+    std::vector<double> newAverages(order.size());
+    std::vector<std::uint32_t> newCounts(order.size());
+    std::vector<std::uint32_t> newIds(order.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        newAverages[i] = averages[order[i]];
+        newCounts[i] = gradeCounts[order[i]];
+        newIds[i] = ids[order[i]];
+    }
+    averages.swap(newAverages);
+    gradeCounts.swap(newCounts);
+    ids.swap(newIds);
+}
+
+void StudentColumns::rebuild(const std::vector<Student*>& students) {
+    clear();
+    reserve(students.size());
+    for (const auto* student : students) {
+        push(*student);
+    }
+}
+
+void StudentColumns::clear() {
+    averages.clear();
+    gradeCounts.clear();
+    ids.clear();
+}
+
+void StudentColumns::reserve(size_t count) {
+    averages.reserve(count);
+    gradeCounts.reserve(count);
+    ids.reserve(count);
+}
+
+// Четыре независимые суммы: без зависимости между итерациями цикл
+// раскладывается компилятором на векторные регистры
+double StudentColumns::sumAverages(size_t begin, size_t end) const {
+    double partial[4] = { 0.0, 0.0, 0.0, 0.0 };
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        partial[0] += averages[i];
+        partial[1] += averages[i + 1];
+        partial[2] += averages[i + 2];
+        partial[3] += averages[i + 3];
+    }
+    for (; i < end; ++i) partial[0] += averages[i];
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
\ No newline at end of file
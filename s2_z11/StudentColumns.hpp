@@ -0,0 +1,44 @@
+#ifndef STUDENTCOLUMNS_HPP
+#define STUDENTCOLUMNS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Student;
+
+// Горячие данные студентов группы в виде структуры массивов: позиция i
+// соответствует students[i]. Полные проходы (среднее, порог, сортировка)
+// читают подряд лежащие double вместо цепочки Student* -> RecordBook.
+// id выдаётся при добавлении в группу и не меняется при перестановках
+class StudentColumns {
+private:
+    std::vector<double> averages;
+    std::vector<std::uint32_t> gradeCounts;
+    std::vector<std::uint32_t> ids;
+    std::uint32_t nextId;
+
+public:
+    StudentColumns();
+
+    void push(const Student& student);
+    void update(size_t slot, const Student& student);
+    void erase(size_t slot);
+    void swapErase(size_t slot);
+    void move(size_t from, size_t to);
+    void truncate(size_t count);
+    void permute(const std::vector<size_t>& order);
+    void rebuild(const std::vector<Student*>& students);
+    void clear();
+    void reserve(size_t count);
+
+    double sumAverages(size_t begin, size_t end) const;
+
+    inline size_t size() const { return averages.size(); }
+    inline double getAverage(size_t slot) const { return averages[slot]; }
+    inline std::uint32_t getGradeCount(size_t slot) const { return gradeCounts[slot]; }
+    inline std::uint32_t getId(size_t slot) const { return ids[slot]; }
+    inline const double* getAverages() const { return averages.data(); }
+};
+
+#endif
\ No newline at end of file
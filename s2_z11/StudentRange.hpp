@@ -0,0 +1,227 @@
+#ifndef STUDENTRANGE_HPP
+#define STUDENTRANGE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "Student.hpp"
+
+// Ленивые представления над списком студентов группы:
+//   group.where(pred).where(pred2).orderBy(key).take(n)
+// Условия складываются в один предикат на этапе компиляции, промежуточные
+// векторы не создаются: фильтрация выполняется при обходе. Представление
+// не владеет студентами и действительно, пока группа не изменяется
+
+struct AnyStudent {
+    bool operator()(const Student&) const { return true; }
+};
+
+template <typename First, typename Second>
+struct BothPredicates {
+    First first;
+    Second second;
+
+    bool operator()(const Student& student) const {
+        return first(student) && second(student);
+    }
+};
+
+template <typename Predicate, typename Key, typename Compare>
+class OrderedStudentRange;
+
+template <typename Predicate>
+class StudentRange {
+private:
+    const std::vector<Student*>* source;
+    Predicate predicate;
+    size_t limit;
+
+public:
+    class iterator {
+    private:
+        Student* const* current;
+        Student* const* last;
+        const Predicate* predicate;
+        size_t remaining;
+
+        // Пропуск неподходящих; по исчерпании лимита итератор становится концом
+        void settle() {
+            if (remaining == 0) {
+                current = last;
+                return;
+            }
+            while (current != last && !(*predicate)(**current)) ++current;
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Student;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Student*;
+        using reference = const Student&;
+
+        iterator() : current(nullptr), last(nullptr), predicate(nullptr), remaining(0) {}
+        iterator(Student* const* current, Student* const* last, const Predicate* predicate,
+            size_t remaining)
+            : current(current), last(last), predicate(predicate), remaining(remaining) {
+            settle();
+        }
+
+        const Student& operator*() const { return **current; }
+        const Student* operator->() const { return *current; }
+        iterator& operator++() {
+            ++current;
+            --remaining;
+            settle();
+            return *this;
+        }
+        iterator operator++(int) { iterator old = *this; ++(*this); return old; }
+        bool operator==(const iterator& other) const { return current == other.current; }
+        bool operator!=(const iterator& other) const { return current != other.current; }
+    };
+
+    StudentRange(const std::vector<Student*>& source, Predicate predicate,
+        size_t limit = static_cast<size_t>(-1))
+        : source(&source), predicate(std::move(predicate)), limit(limit) {
+    }
+
+    iterator begin() const {
+        return iterator(source->data(), source->data() + source->size(), &predicate, limit);
+    }
+
+    iterator end() const {
+        Student* const* last = source->data() + source->size();
+        return iterator(last, last, &predicate, 0);
+    }
+
+    template <typename Next>
+    StudentRange<BothPredicates<Predicate, Next>> where(Next next) const {
+        return StudentRange<BothPredicates<Predicate, Next>>(*source,
+            BothPredicates<Predicate, Next>{ predicate, std::move(next) }, limit);
+    }
+
+    StudentRange take(size_t count) const {
+        return StudentRange(*source, predicate, std::min(limit, count));
+    }
+
+    // take(n) до orderBy ограничивает вход: упорядочиваются первые n подходящих
+    template <typename Key>
+    OrderedStudentRange<Predicate, Key, std::less<>> orderBy(Key key) const {
+        return OrderedStudentRange<Predicate, Key, std::less<>>(*source, predicate, std::move(key),
+            limit);
+    }
+
+    template <typename Key>
+    OrderedStudentRange<Predicate, Key, std::greater<>> orderByDescending(Key key) const {
+        return OrderedStudentRange<Predicate, Key, std::greater<>>(*source, predicate,
+            std::move(key), limit);
+    }
+
+    size_t count() const { return static_cast<size_t>(std::distance(begin(), end())); }
+    bool empty() const { return begin() == end(); }
+
+    std::vector<Student*> toVector() const {
+        std::vector<Student*> result;
+        for (Student* const* it = source->data(); it != source->data() + source->size()
+            && result.size() < limit; ++it) {
+            if (predicate(**it)) result.push_back(*it);
+        }
+        return result;
+    }
+};
+
+// Упорядоченное представление. Порядок нельзя получить без буфера, поэтому
+// при первом обходе отбираются не более take(n) лучших через кучу размера n
+// (O(m log n)) - это единственная аллокация всей цепочки. inputLimit -
+// take(n), применённый до orderBy: просматриваются только первые n подходящих
+template <typename Predicate, typename Key, typename Compare>
+class OrderedStudentRange {
+private:
+    const std::vector<Student*>* source;
+    Predicate predicate;
+    Key key;
+    size_t inputLimit;
+    size_t limit;
+    std::vector<const Student*> ordered;
+    bool evaluated;
+
+    bool before(const Student* a, const Student* b) const {
+        return Compare()(key(*a), key(*b));
+    }
+
+    void evaluate() {
+        evaluated = true;
+        ordered.clear();
+        if (limit == 0) return;
+        auto worseLast = [this](const Student* a, const Student* b) { return before(a, b); };
+        size_t matched = 0;
+        for (const Student* student : *source) {
+            if (matched == inputLimit) break;
+            if (!predicate(*student)) continue;
+            ++matched;
+            if (ordered.size() < limit) {
+                ordered.push_back(student);
+                std::push_heap(ordered.begin(), ordered.end(), worseLast);
+            }
+            else if (before(student, ordered.front())) {
+                std::pop_heap(ordered.begin(), ordered.end(), worseLast);
+                ordered.back() = student;
+                std::push_heap(ordered.begin(), ordered.end(), worseLast);
+            }
+        }
+        std::sort_heap(ordered.begin(), ordered.end(), worseLast);
+    }
+
+public:
+    class iterator {
+    private:
+        const Student* const* current;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Student;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Student*;
+        using reference = const Student&;
+
+        iterator() : current(nullptr) {}
+        explicit iterator(const Student* const* current) : current(current) {}
+
+        const Student& operator*() const { return **current; }
+        const Student* operator->() const { return *current; }
+        iterator& operator++() { ++current; return *this; }
+        iterator operator++(int) { iterator old = *this; ++current; return old; }
+        bool operator==(const iterator& other) const { return current == other.current; }
+        bool operator!=(const iterator& other) const { return current != other.current; }
+    };
+
+    OrderedStudentRange(const std::vector<Student*>& source, Predicate predicate, Key key,
+        size_t inputLimit = static_cast<size_t>(-1), size_t limit = static_cast<size_t>(-1))
+        : source(&source), predicate(std::move(predicate)), key(std::move(key)),
+        inputLimit(inputLimit), limit(limit), evaluated(false) {
+    }
+
+    iterator begin() {
+        if (!evaluated) evaluate();
+        return iterator(ordered.data());
+    }
+
+    iterator end() {
+        if (!evaluated) evaluate();
+        return iterator(ordered.data() + ordered.size());
+    }
+
+    OrderedStudentRange take(size_t count) const {
+        return OrderedStudentRange(*source, predicate, key, inputLimit, std::min(limit, count));
+    }
+
+    size_t count() {
+        if (!evaluated) evaluate();
+        return ordered.size();
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "StudentStore.hpp"
+
+StudentStore::StudentStore() : slotCount(0), freeHead(NoSlot), liveCount(0) {}
+
+// Студенты удаляются до страниц: их группы получают onStudentDestroyed
+StudentStore::~StudentStore() { clear(); }
+
+StudentStore::Slot& StudentStore::slotAt(std::uint32_t index) const {
+    return pages[index / PageSize][index % PageSize];
+}
+
+// Сначала свободный слот из списка, затем новый; страница выделяется
+// только когда заняты все слоты предыдущих
+std::uint32_t StudentStore::acquireSlot() {
+    if (freeHead != NoSlot) {
+        std::uint32_t index = freeHead;
+        freeHead = slotAt(index).nextFree;
+        slotAt(index).nextFree = NoSlot;
+        return index;
+    }
+    if (slotCount % PageSize == 0) {
+        pages.push_back(std::make_unique<Slot[]>(PageSize));
+    }
+    return slotCount++;
+}
+
+bool StudentStore::destroy(StudentHandle handle) {
+    if (!get(handle)) return false;
+    Slot& slot = slotAt(handle.index);
+    slot.student.reset();
+    ++slot.generation;
+    slot.nextFree = freeHead;
+    freeHead = handle.index;
+    --liveCount;
+    return true;
+}
+
+Student* StudentStore::get(StudentHandle handle) const {
+    if (handle.index >= slotCount) return nullptr;
+    Slot& slot = slotAt(handle.index);
+    if (slot.generation != handle.generation || !slot.student) return nullptr;
+    return &*slot.student;
+}
+
+// Номер слота проверяется по адресу: студент другого хранилища может
+// нести тот же номер
+StudentHandle StudentStore::handleOf(const Student* student) const {
+    if (!student || student->getStoreSlot() >= slotCount) return StudentHandle{ NoSlot, 0 };
+    std::uint32_t index = student->getStoreSlot();
+    const Slot& slot = slotAt(index);
+    if (!slot.student || &*slot.student != student) return StudentHandle{ NoSlot, 0 };
+    return StudentHandle{ index, slot.generation };
+}
+
+void StudentStore::clear() {
+    for (std::uint32_t index = 0; index < slotCount; ++index) {
+        Slot& slot = slotAt(index);
+        if (!slot.student) continue;
+        destroy(StudentHandle{ index, slot.generation });
+    }
+}
\ No newline at end of file
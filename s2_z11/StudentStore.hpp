@@ -0,0 +1,77 @@
+#ifndef STUDENTSTORE_HPP
+#define STUDENTSTORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+#include "Student.hpp"
+
+// Дескриптор студента в StudentStore: номер слота и поколение слота.
+// После удаления студента поколение растёт, и старый дескриптор
+// перестаёт разыменовываться вместо того, чтобы указывать на чужие данные
+struct StudentHandle {
+    std::uint32_t index;
+    std::uint32_t generation;
+
+    bool operator==(const StudentHandle& other) const {
+        return index == other.index && generation == other.generation;
+    }
+    bool operator!=(const StudentHandle& other) const { return !(*this == other); }
+};
+
+// Хранилище студентов со слотами многократного использования (slot map).
+// Слоты лежат страницами по PageSize и никогда не переезжают, поэтому
+// группы могут хранить Student* на студентов из хранилища. Освобождённые
+// слоты образуют список и занимаются заново; проверка дескриптора - O(1)
+class StudentStore {
+public:
+    static const size_t PageSize = 256;
+    static const std::uint32_t NoSlot = static_cast<std::uint32_t>(-1);
+
+private:
+    struct Slot {
+        std::optional<Student> student;
+        std::uint32_t generation = 0;
+        std::uint32_t nextFree = NoSlot;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> pages;
+    std::uint32_t slotCount;
+    std::uint32_t freeHead;
+    size_t liveCount;
+
+    Slot& slotAt(std::uint32_t index) const;
+    std::uint32_t acquireSlot();
+
+public:
+    StudentStore();
+    StudentStore(const StudentStore&) = delete;
+    StudentStore& operator=(const StudentStore&) = delete;
+    ~StudentStore();
+
+    template <typename... Args>
+    StudentHandle create(Args&&... args) {
+        std::uint32_t index = acquireSlot();
+        Slot& slot = slotAt(index);
+        slot.student.emplace(std::forward<Args>(args)...);
+        slot.student->setStoreSlot(index);
+        ++liveCount;
+        return StudentHandle{ index, slot.generation };
+    }
+
+    bool destroy(StudentHandle handle);
+    Student* get(StudentHandle handle) const;
+    // Обратный поиск по адресу студента: O(1), слот записан в самом студенте.
+    // Для студента не из этого хранилища index == NoSlot
+    StudentHandle handleOf(const Student* student) const;
+    void clear();
+
+    inline bool isValid(StudentHandle handle) const { return get(handle) != nullptr; }
+    inline size_t size() const { return liveCount; }
+    inline bool empty() const { return liveCount == 0; }
+};
+
+#endif
\ No newline at end of file
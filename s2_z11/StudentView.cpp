@@ -0,0 +1,8 @@
+#include "StudentView.hpp"
+
+double StudentView::getAverage() const {
+    if (grades.empty()) return 0.0;
+    double sum = 0.0;
+    for (double grade : grades) sum += grade;
+    return sum / grades.size();
+}
\ No newline at end of file
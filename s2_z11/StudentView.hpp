@@ -0,0 +1,33 @@
+#ifndef STUDENTVIEW_HPP
+#define STUDENTVIEW_HPP
+
+#include <string_view>
+#include "GradeView.hpp"
+
+// Лёгкое представление студента из файла группы: имя, номер зачётки
+// и оценки указывают в чужой буфер (отображение файла или пакет потокового
+// чтения), ничего не копируется. Действительно, пока жив этот буфер
+class StudentView {
+private:
+    std::string_view name;
+    std::string_view recordNumber;
+    GradeView grades;
+    double gradeStep;
+
+public:
+    StudentView() : gradeStep(0.0) {}
+    StudentView(std::string_view name, std::string_view recordNumber, GradeView grades,
+        double gradeStep)
+        : name(name), recordNumber(recordNumber), grades(grades), gradeStep(gradeStep) {
+    }
+
+    std::string_view getName() const { return name; }
+    std::string_view getRecordNumber() const { return recordNumber; }
+    GradeView getGrades() const { return grades; }
+    double getGradeStep() const { return gradeStep; }
+    double getAverage() const;
+
+    inline bool hasGrades() const { return !grades.empty(); }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,307 @@
+#include "SubjectGradeTable.hpp"
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <utility>
+
+static const double MissingGrade = std::numeric_limits<double>::quiet_NaN();
+
+SubjectGradeTable::RowView::RowView(const SubjectGradeTable* table, size_t row)
+    : table(table), row(row) {
+}
+
+const std::string& SubjectGradeTable::RowView::getRecordNumber() const {
+    return table->recordNumbers[row];
+}
+
+double SubjectGradeTable::RowView::getGrade(size_t subject) const {
+    return table->columns[subject][row];
+}
+
+bool SubjectGradeTable::RowView::hasGrade(size_t subject) const {
+    return isPresent(table->columns[subject][row]);
+}
+
+int SubjectGradeTable::RowView::getGradeCount() const {
+    int count = 0;
+    for (const auto& column : table->columns) {
+        if (isPresent(column[row])) ++count;
+    }
+    return count;
+}
+
+double SubjectGradeTable::RowView::getAverage() const {
+    double sum = 0.0;
+    int count = 0;
+    for (const auto& column : table->columns) {
+        if (isPresent(column[row])) {
+            sum += column[row];
+            ++count;
+        }
+    }
+    return count ? sum / count : 0.0;
+}
+
+double SubjectGradeTable::RowView::getHighestGrade() const {
+    double best = -1.0;
+    for (const auto& column : table->columns) {
+        if (isPresent(column[row]) && column[row] > best) best = column[row];
+    }
+    return best < 0.0 ? 0.0 : best;
+}
+
+double SubjectGradeTable::RowView::getLowestGrade() const {
+    double worst = 6.0;
+    for (const auto& column : table->columns) {
+        if (isPresent(column[row]) && column[row] < worst) worst = column[row];
+    }
+    return worst > 5.0 ? 0.0 : worst;
+}
+
+SubjectGradeTable::SubjectGradeTable() {}
+
+SubjectGradeTable::SubjectGradeTable(std::vector<std::string> subjectNames) {
+    for (auto& name : subjectNames) {
+        addSubject(std::move(name));
+    }
+}
+
+// Копия таблицы подписывается на тех же студентов
+SubjectGradeTable::SubjectGradeTable(const SubjectGradeTable& other)
+    : subjects(other.subjects), recordNumbers(other.recordNumbers), columns(other.columns),
+    rowStudents(other.rowStudents), studentRows(other.studentRows) {
+    subscribeRows();
+}
+
+SubjectGradeTable::SubjectGradeTable(SubjectGradeTable&& other) noexcept
+    : subjects(std::move(other.subjects)), recordNumbers(std::move(other.recordNumbers)),
+    columns(std::move(other.columns)), rowStudents(std::move(other.rowStudents)),
+    studentRows(std::move(other.studentRows)) {
+    for (auto* student : rowStudents) {
+        if (student) student->replaceListener(&other, this);
+    }
+    other.rowStudents.clear();
+    other.studentRows.clear();
+}
+
+SubjectGradeTable& SubjectGradeTable::operator=(const SubjectGradeTable& other) {
+    if (this != &other) {
+        unsubscribeRows();
+        subjects = other.subjects;
+        recordNumbers = other.recordNumbers;
+        columns = other.columns;
+        rowStudents = other.rowStudents;
+        studentRows = other.studentRows;
+        subscribeRows();
+    }
+    return *this;
+}
+
+SubjectGradeTable& SubjectGradeTable::operator=(SubjectGradeTable&& other) noexcept {
+    if (this != &other) {
+        unsubscribeRows();
+        subjects = std::move(other.subjects);
+        recordNumbers = std::move(other.recordNumbers);
+        columns = std::move(other.columns);
+        rowStudents = std::move(other.rowStudents);
+        studentRows = std::move(other.studentRows);
+        for (auto* student : rowStudents) {
+            if (student) student->replaceListener(&other, this);
+        }
+        other.rowStudents.clear();
+        other.studentRows.clear();
+    }
+    return *this;
+}
+
+SubjectGradeTable::~SubjectGradeTable() {
+    unsubscribeRows();
+}
+
+// Подписка - по одной на строку, как у группы на каждое вхождение
+void SubjectGradeTable::subscribeRows() {
+    for (auto* student : rowStudents) {
+        if (student) student->subscribe(this);
+    }
+}
+
+void SubjectGradeTable::unsubscribeRows() {
+    for (auto* student : rowStudents) {
+        if (student) student->unsubscribe(this);
+    }
+}
+
+void SubjectGradeTable::rebuildRow(size_t row) {
+    GradeView grades = rowStudents[row]->getGrades();
+    bool matches = grades.size() == columns.size();
+    for (size_t subject = 0; subject < columns.size(); ++subject) {
+        columns[subject][row] = matches ? grades[subject] : MissingGrade;
+    }
+}
+
+void SubjectGradeTable::onGradesChanging(Student& student) {
+    (void)student;
+}
+
+void SubjectGradeTable::onGradesChanged(Student& student) {
+    auto range = studentRows.equal_range(&student);
+    for (auto it = range.first; it != range.second; ++it) {
+        rebuildRow(it->second);
+    }
+}
+
+// Строки удалённого студента остаются с последними оценками
+void SubjectGradeTable::onStudentDestroyed(Student& student) {
+    auto range = studentRows.equal_range(&student);
+    for (auto it = range.first; it != range.second; ++it) {
+        rowStudents[it->second] = nullptr;
+    }
+    studentRows.erase(range.first, range.second);
+}
+
+// Узлы переносятся без выделения памяти
+void SubjectGradeTable::onStudentMoved(Student& from, Student& to) {
+    while (true) {
+        auto it = studentRows.find(&from);
+        if (it == studentRows.end()) break;
+        rowStudents[it->second] = &to;
+        auto node = studentRows.extract(it);
+        node.key() = &to;
+        studentRows.insert(std::move(node));
+    }
+}
+
+// i-я оценка зачётки студента относится к i-му предмету, как в матрице
+// оценок. Студенты с другим числом оценок пропускаются
+SubjectGradeTable SubjectGradeTable::fromGroup(const Group& group,
+    std::vector<std::string> subjectNames) {
+    SubjectGradeTable table(std::move(subjectNames));
+    table.reserveRows(group.getStudentCount());
+    for (auto* student : group.getStudents()) {
+        table.addRow(*student);
+    }
+    return table;
+}
+
+size_t SubjectGradeTable::addSubject(std::string name) {
+    int existing = findSubject(name);
+    if (existing >= 0) return static_cast<size_t>(existing);
+    subjects.push_back(std::move(name));
+    columns.emplace_back(recordNumbers.size(), MissingGrade);
+    for (size_t row = 0; row < rowStudents.size(); ++row) {
+        if (rowStudents[row]) rebuildRow(row);
+    }
+    return subjects.size() - 1;
+}
+
+int SubjectGradeTable::findSubject(const std::string& name) const {
+    for (size_t i = 0; i < subjects.size(); ++i) {
+        if (subjects[i] == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+size_t SubjectGradeTable::addRow(std::string recordNumber) {
+    recordNumbers.push_back(std::move(recordNumber));
+    rowStudents.push_back(nullptr);
+    for (auto& column : columns) {
+        column.push_back(MissingGrade);
+    }
+    return recordNumbers.size() - 1;
+}
+
+size_t SubjectGradeTable::addRow(Student& student) {
+    GradeView grades = student.getGrades();
+    if (grades.size() != columns.size()) {
+        std::cerr << "Student " << student.getName() << " has " << grades.size()
+            << " grades for " << columns.size() << " subjects, row skipped\n";
+        return NoRow;
+    }
+    size_t row = addRow(student.getRecordNumber());
+    rowStudents[row] = &student;
+    studentRows.emplace(&student, row);
+    student.subscribe(this);
+    rebuildRow(row);
+    return row;
+}
+
+void SubjectGradeTable::reserveRows(size_t rowCount) {
+    recordNumbers.reserve(rowCount);
+    rowStudents.reserve(rowCount);
+    studentRows.reserve(rowCount);
+    for (auto& column : columns) {
+        column.reserve(rowCount);
+    }
+}
+
+bool SubjectGradeTable::setGrade(size_t row, size_t subject, double grade) {
+    if (grade < 0 || grade > 5) return false;
+    if (row >= recordNumbers.size() || subject >= columns.size()) return false;
+    columns[subject][row] = grade;
+    return true;
+}
+
+void SubjectGradeTable::clearGrade(size_t row, size_t subject) {
+    if (row >= recordNumbers.size() || subject >= columns.size()) return;
+    columns[subject][row] = MissingGrade;
+}
+
+SubjectGradeTable::RowView SubjectGradeTable::getRow(size_t row) const {
+    return RowView(this, row);
+}
+
+const double* SubjectGradeTable::getColumn(size_t subject) const {
+    return columns[subject].data();
+}
+
+const std::string& SubjectGradeTable::getSubjectName(size_t subject) const {
+    return subjects[subject];
+}
+
+size_t SubjectGradeTable::getRowCount() const { return recordNumbers.size(); }
+size_t SubjectGradeTable::getSubjectCount() const { return subjects.size(); }
+
+double SubjectGradeTable::getSubjectAverage(size_t subject) const {
+    double sum = 0.0;
+    size_t count = 0;
+    for (double grade : columns[subject]) {
+        if (isPresent(grade)) {
+            sum += grade;
+            ++count;
+        }
+    }
+    return count ? sum / count : 0.0;
+}
+
+double SubjectGradeTable::getSubjectHighest(size_t subject) const {
+    double best = -1.0;
+    for (double grade : columns[subject]) {
+        if (isPresent(grade) && grade > best) best = grade;
+    }
+    return best < 0.0 ? 0.0 : best;
+}
+
+double SubjectGradeTable::getSubjectLowest(size_t subject) const {
+    double worst = 6.0;
+    for (double grade : columns[subject]) {
+        if (isPresent(grade) && grade < worst) worst = grade;
+    }
+    return worst > 5.0 ? 0.0 : worst;
+}
+
+size_t SubjectGradeTable::getSubjectGradeCount(size_t subject) const {
+    size_t count = 0;
+    for (double grade : columns[subject]) {
+        if (isPresent(grade)) ++count;
+    }
+    return count;
+}
+
+void SubjectGradeTable::print() const {
+    std::cout << "Subjects: " << subjects.size() << ", students: " << recordNumbers.size() << "\n";
+    for (size_t i = 0; i < subjects.size(); ++i) {
+        std::cout << "  " << subjects[i] << ": avg " << std::fixed << std::setprecision(2)
+            << getSubjectAverage(i) << ", max " << getSubjectHighest(i)
+            << ", min " << getSubjectLowest(i) << ", graded " << getSubjectGradeCount(i) << "\n";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#ifndef SUBJECTGRADETABLE_HPP
+#define SUBJECTGRADETABLE_HPP
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Group.hpp"
+#include "GradeListener.hpp"
+
+// Колоночная таблица оценок "студенты x предметы". Оценки одного предмета
+// по всей группе лежат подряд, поэтому статистика по предмету - это один
+// линейный проход. Пустая ячейка хранится как NaN.
+// Оценки принадлежат зачёткам, таблица - их колоночная копия. Строка,
+// добавленная из студента, подписана на него и перестраивается после
+// каждого изменения его оценок, поэтому не устаревает; ручные правки
+// такой строки заменяются при следующей перестройке. Оценки зачётки
+// сопоставляются предметам по порядку: студент с другим числом оценок
+// не принимается, а если число разошлось позже, его строка пуста
+class SubjectGradeTable : private GradeListener {
+private:
+    std::vector<std::string> subjects;
+    std::vector<std::string> recordNumbers;
+    std::vector<std::vector<double>> columns;
+    // Студент каждой строки; nullptr - строка без студента
+    std::vector<Student*> rowStudents;
+    std::unordered_multimap<const Student*, size_t> studentRows;
+
+    static bool isPresent(double value) { return value == value; }
+
+    void rebuildRow(size_t row);
+    void subscribeRows();
+    void unsubscribeRows();
+
+    void onGradesChanging(Student& student) override;
+    void onGradesChanged(Student& student) override;
+    void onStudentDestroyed(Student& student) override;
+    void onStudentMoved(Student& from, Student& to) override;
+
+public:
+    static const size_t NoRow = static_cast<size_t>(-1);
+
+    // Строка таблицы с интерфейсом зачётки: оценки студента по всем предметам
+    class RowView {
+    private:
+        const SubjectGradeTable* table;
+        size_t row;
+
+    public:
+        RowView(const SubjectGradeTable* table, size_t row);
+
+        const std::string& getRecordNumber() const;
+        double getGrade(size_t subject) const;
+        bool hasGrade(size_t subject) const;
+        int getGradeCount() const;
+        double getAverage() const;
+        double getHighestGrade() const;
+        double getLowestGrade() const;
+    };
+
+    SubjectGradeTable();
+    explicit SubjectGradeTable(std::vector<std::string> subjectNames);
+    SubjectGradeTable(const SubjectGradeTable& other);
+    SubjectGradeTable(SubjectGradeTable&& other) noexcept;
+    SubjectGradeTable& operator=(const SubjectGradeTable& other);
+    SubjectGradeTable& operator=(SubjectGradeTable&& other) noexcept;
+    ~SubjectGradeTable();
+
+    static SubjectGradeTable fromGroup(const Group& group, std::vector<std::string> subjectNames);
+
+    size_t addSubject(std::string name);
+    int findSubject(const std::string& name) const;
+    size_t addRow(std::string recordNumber);
+    // NoRow, если число оценок студента не равно числу предметов
+    size_t addRow(Student& student);
+    void reserveRows(size_t rowCount);
+
+    bool setGrade(size_t row, size_t subject, double grade);
+    void clearGrade(size_t row, size_t subject);
+
+    RowView getRow(size_t row) const;
+    const double* getColumn(size_t subject) const;
+    const std::string& getSubjectName(size_t subject) const;
+    size_t getRowCount() const;
+    size_t getSubjectCount() const;
+
+    double getSubjectAverage(size_t subject) const;
+    double getSubjectHighest(size_t subject) const;
+    double getSubjectLowest(size_t subject) const;
+    size_t getSubjectGradeCount(size_t subject) const;
+
+    void print() const;
+};
+
+#endif
\ No newline at end of file
@@ -1,19 +1,20 @@
 #include "Teacher.hpp"
 #include <iostream>
+#include <utility>
 
 Teacher::Teacher() : Person(), subject("Unknown"), experience(0) {}
 
-Teacher::Teacher(const std::string& name, const std::string& subject)
-    : Person(name), subject(subject), experience(0) {
+Teacher::Teacher(std::string name, std::string subject)
+    : Person(std::move(name)), subject(std::move(subject)), experience(0) {
 }
 
-Teacher::Teacher(const std::string& name, const std::string& subject, int experience)
-    : Person(name), subject(subject), experience(experience) {
+Teacher::Teacher(std::string name, std::string subject, int experience)
+    : Person(std::move(name)), subject(std::move(subject)), experience(experience) {
 }
 
 std::string Teacher::getSubject() const { return subject; }
 int Teacher::getExperience() const { return experience; }
-void Teacher::setSubject(const std::string& newSubject) { subject = newSubject; }
+void Teacher::setSubject(std::string newSubject) { subject = std::move(newSubject); }
 void Teacher::setExperience(int years) { experience = years; }
 
 void Teacher::print() const {
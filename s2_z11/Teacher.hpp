@@ -4,19 +4,19 @@
 #include "Person.hpp"
 #include <string>
 
-class Teacher : public Person {
+class Teacher final : public Person {
 private:
     std::string subject;
     int experience;
 
 public:
     Teacher();
-    Teacher(const std::string& name, const std::string& subject);
-    Teacher(const std::string& name, const std::string& subject, int experience);
+    Teacher(std::string name, std::string subject);
+    Teacher(std::string name, std::string subject, int experience);
 
     std::string getSubject() const;
     int getExperience() const;
-    void setSubject(const std::string& newSubject);
+    void setSubject(std::string newSubject);
     void setExperience(int years);
 
     void print() const override;
@@ -1,32 +1,53 @@
 #include <iostream>
 #include <vector>
 #include <memory>
+#include <iomanip>
+#include <cstdio>
+#include <cstring>
 #include "Student.hpp"
 #include "Teacher.hpp"
 #include "Group.hpp"
 #include "FileManager.hpp"
+#include "Benchmark.hpp"
+#include "SubjectGradeTable.hpp"
+#include "MembershipRegistry.hpp"
+#include "StudentStore.hpp"
+#include "GroupSelection.hpp"
+#include "MappedGroupFile.hpp"
+#include "GradeJournal.hpp"
+#include "SelfTest.hpp"
+
+int main(int argc, char* argv[]) {
+    // Бенчмарки идут долго и пишут большие временные файлы, поэтому
+    // запускаются только отдельно: s2_z11 --benchmark
+    if (argc > 1 && std::strcmp(argv[1], "--benchmark") == 0) {
+        Benchmark::runAll();
+        return 0;
+    }
 
-int main() {
     std::cout << "========================================\n";
     std::cout << "TASK 11: MULTI-MODULE PROJECT\n";
     std::cout << "========================================\n\n";
 
-    // Создание студентов
+    // Создание студентов в хранилище со слотами
     std::cout << "--- Creating students ---\n";
-    Student* s1 = new Student("Alice", "2024001", { 4.5, 3.8, 5.0, 4.2 });
-    Student* s2 = new Student("Bob", "2024002", { 3.5, 4.0, 3.8, 4.5 });
-    Student* s3 = new Student("Charlie", "2024003", { 2.5, 3.0, 2.8, 3.2 });
-    Student* s4 = new Student("Diana", "2024004", { 4.8, 4.5, 4.9, 4.7 });
+    StudentStore store;
+    StudentHandle h1 = store.create("Alice", "2024001", std::vector<double>{ 4.5, 3.8, 5.0, 4.2 });
+    StudentHandle h2 = store.create("Bob", "2024002", std::vector<double>{ 3.5, 4.0, 3.8, 4.5 });
+    StudentHandle h3 = store.create("Charlie", "2024003", std::vector<double>{ 2.5, 3.0, 2.8, 3.2 });
+    StudentHandle h4 = store.create("Diana", "2024004", std::vector<double>{ 4.8, 4.5, 4.9, 4.7 });
+    Student* s1 = store.get(h1);
+    Student* s2 = store.get(h2);
+    Student* s3 = store.get(h3);
+    Student* s4 = store.get(h4);
 
     // Создание группы
     Group group("CS-2024");
 
     // Добавление студентов в группу
     std::cout << "\n--- Adding students to group ---\n";
-    group.addStudent(s1);
-    group.addStudent(s2);
-    group.addStudent(s3);
-    group.addStudent(s4);
+    std::vector<Student*> enrollment = { s1, s2, s3, s4 };
+    group.addStudents(enrollment, true);
 
     // Вывод группы
     group.print();
@@ -38,11 +59,36 @@ int main() {
 
     // Фильтрация по порогу
     std::cout << "\n--- Filtering students with average >= 4.0 ---\n";
-    auto filtered = group.filterByThreshold(4.0);
-    for (const auto* student : filtered) {
+    auto isGood = [](const Student& student) { return student.getAverage() >= 4.0; };
+    for (const Student& student : group.where(isGood)) {
+        student.print();
+        std::cout << "\n";
+    }
+
+    // Ленивая цепочка: фильтр, порядок по имени и ограничение
+    std::cout << "\n--- Students with average >= 3.0, first 2 by name ---\n";
+    auto byName = [](const Student& student) -> const std::string& { return student.getName(); };
+    for (const Student& student : group.where([](const Student& student) {
+        return student.getAverage() >= 3.0;
+        }).orderBy(byName).take(2)) {
+        student.print();
+        std::cout << "\n";
+    }
+
+    // Рейтинг без пересортировки
+    std::cout << "\n--- Ranking: top 2 and rank of Bob ---\n";
+    for (const auto* student : group.topK(2)) {
         student->print();
         std::cout << "\n";
     }
+    std::cout << "Bob's rank: " << group.rankOf(s2) + 1 << " of "
+        << group.getStudentCount() << "\n";
+
+    // Колоночная таблица оценок по предметам
+    std::cout << "\n--- Per-subject statistics ---\n";
+    SubjectGradeTable table = SubjectGradeTable::fromGroup(group,
+        { "Math", "Physics", "Programming", "History" });
+    table.print();
 
     // Сохранение в файл
     std::cout << "\n--- Saving group to file ---\n";
@@ -51,20 +97,97 @@ int main() {
     // Загрузка из файла
     std::cout << "\n--- Loading group from file ---\n";
     Group loadedGroup;
-    FileManager::loadGroup(loadedGroup, "group.bin");
+    FileManager::loadGroup(loadedGroup, store, "group.bin");
     loadedGroup.print();
 
+    // Чтение без создания объектов: представления указывают в отображённый файл
+    std::cout << "\n--- Reading group file through a memory map ---\n";
+    MappedGroupFile mapped;
+    if (mapped.open("group.bin")) {
+        std::cout << "Group " << mapped.getName() << ", students: "
+            << mapped.getStudentCount() << "\n";
+        for (size_t i = 0; i < mapped.getStudentCount(); ++i) {
+            StudentView view = mapped.getStudent(i);
+            std::cout << "  " << view.getName() << " (" << view.getRecordNumber() << "): "
+                << view.getGrades().size() << " grades, avg " << std::fixed
+                << std::setprecision(2) << view.getAverage() << "\n";
+        }
+        mapped.close();
+    }
+
+    // Журнал операций поверх снимка: изменения не требуют перезаписи файла
+    std::cout << "\n--- Grade journal ---\n";
+    {
+        GradeJournal journal;
+        if (journal.open("journal_group.bin", "journal_group.log", "CS-2024")) {
+            journal.enrollStudent("Eve", "2024005");
+            journal.addGrade("Eve", 4.5);
+            journal.addGrade("Eve", 3.9);
+            journal.startCompaction();
+            journal.waitForCompaction();
+            journal.addGrade("Eve", 5.0);
+            journal.close();
+
+            // После перезапуска: снимок плюс одна запись журнала
+            journal.open("journal_group.bin", "journal_group.log");
+            journal.inspect([](const Group& journaled) { journaled.print(); });
+            journal.close();
+        }
+        std::remove("journal_group.bin");
+        std::remove("journal_group.log");
+    }
+
     // Удаление студента
     std::cout << "\n--- Removing Bob from group ---\n";
     group.removeStudent("Bob");
     group.print();
 
+    // Пересечения групп через реестр членства
+    std::cout << "\n--- Membership registry ---\n";
+    {
+        Group math("Math");
+        math.addStudent(s1);
+        math.addStudent(s2);
+        Group physics("Physics");
+        physics.addStudent(s2);
+        physics.addStudent(s4);
+
+        MembershipRegistry registry;
+        registry.watch(group);
+        registry.watch(math);
+        registry.watch(physics);
+
+        std::cout << "In Math and Physics:";
+        for (const auto* student : registry.resolve(
+            registry.getMembers(math) & registry.getMembers(physics))) {
+            std::cout << " " << student->getName();
+        }
+        std::cout << "\nIn CS-2024 but not Math:";
+        for (const auto* student : registry.resolve(
+            registry.getMembers(group).andNot(registry.getMembers(math)))) {
+            std::cout << " " << student->getName();
+        }
+        std::cout << "\nBob is in " << registry.countGroupsOf(s2) << " group(s)\n";
+
+        std::cout << "Top 2 across Math and Physics:";
+        for (const auto* student : GroupSelection::topK({ &math, &physics }, 2)) {
+            std::cout << " " << student->getName();
+        }
+        std::cout << "\n";
+    }
+
+    std::cout << "\n--- Self-test ---\n";
+    if (!SelfTest::runAll()) {
+        std::cerr << "Self-test failed\n";
+    }
+
     // Освобождение памяти
     std::cout << "\n--- Cleaning up ---\n";
-    delete s1;
-    delete s2;
-    delete s3;
-    delete s4;
+    store.destroy(h1);
+    store.destroy(h2);
+    store.destroy(h3);
+    store.destroy(h4);
+    std::cout << "Stale handle detected: " << (store.get(h2) == nullptr ? "yes" : "no") << "\n";
 
     std::cout << "\nAll memory freed. Program completed.\n";
     return 0;